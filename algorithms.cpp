@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+#include "algorithms.h"
+#include "exceptions.h"
+#include "primes.h"
+
+// Levels of product trees pair the halves: next[j] = current[j] * current[j + half] for half = current.size() / 2,
+// the last node of an odd level goes up as it is. The halves are contiguous spans, so they are multiplied
+// by a batch with no copies of the nodes
+
+static vector<BigInteger> next_level(std::span<const BigInteger> current, size_t threads_count) {
+    size_t half = current.size() / 2;
+    vector<BigInteger> next(half);
+    BigInteger::multiply_batch(current.first(half), current.subspan(half, half), next, threads_count);
+    // the odd node is the only one which is copied
+    if (current.size() % 2 == 1) next.push_back(current.back());
+    return next;
+}
+
+// replaces the level by the next one in place
+static void multiply_halves(vector<BigInteger>& current, size_t threads_count) {
+    size_t half = current.size() / 2;
+    std::span<BigInteger> nodes(current);
+    BigInteger::multiply_batch(nodes.first(half), nodes.subspan(half, half), nodes.first(half), threads_count);
+    if (current.size() % 2 == 1) current[half] = std::move(current.back());
+    current.resize(half + current.size() % 2);
+}
+
+// index of the parent of the index-th node of a level of size nodes
+static size_t parent_index(size_t index, size_t size) {
+    size_t half = size / 2;
+    return index < 2 * half ? index % half : half;
+}
+
+// levels[0] are the values, levels[i + 1] = next_level(levels[i]), the last level is the only root
+static vector<vector<BigInteger>> build_product_tree(std::span<const BigInteger> values, size_t threads_count) {
+    vector<vector<BigInteger>> levels(1, vector<BigInteger>(values.begin(), values.end()));
+    while (levels.back().size() > 1) {
+        levels.push_back(next_level(levels.back(), threads_count));
+    }
+    return levels;
+}
+
+BigInteger product_tree(std::span<const BigInteger> values, size_t threads_count) {
+    if (values.empty()) return 1;
+    if (values.size() == 1) return values[0];
+    // only the root is needed, so the levels above the values replace each other
+    vector<BigInteger> level = next_level(values, threads_count);
+    while (level.size() > 1) {
+        multiply_halves(level, threads_count);
+    }
+    return std::move(level[0]);
+}
+
+vector<BigInteger> remainder_tree(const BigInteger& value, std::span<const BigInteger> moduli, size_t threads_count) {
+    if (moduli.empty()) return {};
+    auto levels = build_product_tree(moduli, threads_count);
+
+    // a remainder modulo a product keeps the remainders modulo all its factors
+    vector<BigInteger> remainders(1, value % levels.back()[0]);
+    for (size_t level = levels.size() - 1; level > 0; --level) {
+        const auto& children = levels[level - 1];
+        vector<BigInteger> next(children.size());
+        parallel_for(children.size(), threads_count, [&](size_t i) {
+            next[i] = remainders[parent_index(i, children.size())] % children[i];
+        });
+        remainders = std::move(next);
+    }
+    return remainders;
+}
+
+// the factors are multiplied into machine words first, so the tree gets fewer and longer leaves
+static BigInteger product_of_factors(const vector<unsigned long long>& factors) {
+    vector<BigInteger> words;
+    unsigned long long current = 1;
+    for (auto factor : factors) {
+        if (current > std::numeric_limits<unsigned long long>::max() / factor) {
+            words.push_back(current);
+            current = 1;
+        }
+        current *= factor;
+    }
+    words.push_back(current);
+    return product_tree(words);
+}
+
+// swing(n) = n! / (n / 2)!^2, the exponent of prime p in it is the number of odd floor(n / p^i),
+// so every prime power factor is not greater than n
+static BigInteger prime_swing(unsigned long long n, const vector<unsigned long long>& primes) {
+    vector<unsigned long long> factors;
+    for (auto prime : primes) {
+        if (prime > n) break;
+        unsigned long long prime_power = 1;
+        for (unsigned long long quotient = n / prime; quotient > 0; quotient /= prime) {
+            if (quotient % 2 == 1) prime_power *= prime;
+        }
+        if (prime_power > 1) factors.push_back(prime_power);
+    }
+    return product_of_factors(factors);
+}
+
+const unsigned long long SMALL_FACTORIAL_LIMIT = 20;
+
+static BigInteger factorial_by_swing(unsigned long long n, const vector<unsigned long long>& primes) {
+    if (n <= SMALL_FACTORIAL_LIMIT) {
+        unsigned long long result = 1;
+        for (unsigned long long i = 2; i <= n; ++i) {
+            result *= i;
+        }
+        return result;
+    }
+    BigInteger half = factorial_by_swing(n / 2, primes);
+    BigInteger swing = prime_swing(n, primes);
+    half *= half;
+    half *= swing;
+    return half;
+}
+
+BigInteger factorial(unsigned long long n) {
+    return factorial_by_swing(n, primes_up_to(n));
+}
+
+BigInteger binomial(unsigned long long n, unsigned long long k) {
+    if (k > n) return 0;
+    k = std::min(k, n - k);
+    if (k == 0) return 1;
+
+    // the sieve takes time and memory linear in n, while the falling factorial n * (n - 1) * ... * (n - k + 1)
+    // has k factors of the length of n, so it is cheaper for small k
+    if (k < n / std::bit_width(n)) {
+        vector<unsigned long long> factors(k);
+        for (unsigned long long i = 0; i < k; ++i) {
+            factors[i] = n - i;
+        }
+        return BigInteger::divexact(product_of_factors(factors), factorial(k));
+    }
+
+    // the exponent of p is the number of carries when adding k and n - k in base p (Kummer's theorem),
+    // every carry is floor(n / p^i) - floor(k / p^i) - floor((n - k) / p^i) = 1,
+    // so every prime power factor is not greater than n
+    vector<unsigned long long> factors;
+    for (auto prime : primes_up_to(n)) {
+        unsigned long long prime_power = 1;
+        for (unsigned long long whole = n / prime, first = k / prime, second = (n - k) / prime; whole > 0;
+                whole /= prime, first /= prime, second /= prime) {
+            if (whole - first - second == 1) prime_power *= prime;
+        }
+        if (prime_power > 1) factors.push_back(prime_power);
+    }
+    return product_of_factors(factors);
+}
+
+BigInteger primorial(unsigned long long n) {
+    return product_of_factors(primes_up_to(n));
+}
+
+// checks base^degree <= limit without overflows
+static bool power_not_greater(unsigned long long base, unsigned long long degree, unsigned long long limit) {
+    unsigned long long result = 1;
+    for (unsigned long long i = 0; i < degree; ++i) {
+        if (base != 0 && result > limit / base) return false;
+        result *= base;
+    }
+    return result <= limit;
+}
+
+static unsigned long long small_root(unsigned long long value, unsigned long long degree) {
+    if (value < 2) return value;
+    if (degree >= std::numeric_limits<unsigned long long>::digits) return 1;
+    auto result = static_cast<unsigned long long>(powl(static_cast<long double>(value), 1.0l / degree));
+    while (result > 0 && !power_not_greater(result, degree, value)) --result;
+    while (power_not_greater(result + 1, degree, value)) ++result;
+    return result;
+}
+
+// the longest values which always fit in long long
+const size_t SMALL_ROOT_DIGITS = std::numeric_limits<long long>::digits10;
+
+// floor(value^(1 / degree)) for non-negative value
+static BigInteger root_of_non_negative(const BigInteger& value, unsigned long long degree) {
+    size_t size = value.size();
+    if (size <= SMALL_ROOT_DIGITS) return small_root(static_cast<long long>(value), degree);
+    // 2^degree > 16^size > value
+    if (degree >= 4 * size) return 1;
+
+    // the root has about size / degree digits, the upper half of them is found recursively
+    size_t low_digits = size / degree / 2;
+    if (low_digits == 0) {
+        // the root has at most two digits, binary search is enough
+        BigInteger low = 0;
+        BigInteger high = BigInteger::power(10, (size + degree - 1) / degree);
+        while (low < high) {
+            BigInteger middle = (low + high + 1) / 2;
+            if (BigInteger::power(middle, degree) <= value) {
+                low = middle;
+            } else {
+                high = middle - 1;
+            }
+        }
+        return low;
+    }
+
+    // (root(high) + 1) * BASE^low_digits is not less than the root
+    BigInteger estimate = value;
+    estimate.shift(-static_cast<int>(degree * low_digits));
+    estimate = root_of_non_negative(estimate, degree) + 1;
+    estimate.shift(low_digits);
+
+    // Newton iteration decreases estimate while it is greater than the root
+    while (true) {
+        BigInteger next = value / BigInteger::power(estimate, degree - 1);
+        BigInteger::addmul_1(next, estimate, degree - 1);
+        next /= degree;
+        if (next >= estimate) return estimate;
+        estimate = std::move(next);
+    }
+}
+
+BigInteger isqrt(const BigInteger& value) {
+    return iroot(value, 2);
+}
+
+void isqrt_rem(const BigInteger& value, BigInteger& root, BigInteger& remainder) {
+    BigInteger result = isqrt(value);
+    remainder = value;
+    BigInteger::submul(remainder, result, result);
+    root = std::move(result);
+}
+
+BigInteger iroot(const BigInteger& value, unsigned long long degree) {
+    if (degree == 0) throw InvalidArgumentException("0", "a positive degree");
+    if (value.is_negative()) {
+        if (degree % 2 == 0) throw InvalidArgumentException(value.toString(), "a non-negative value for an even degree");
+        return -root_of_non_negative(-value, degree);
+    }
+    return root_of_non_negative(value, degree);
+}
+
+bool is_perfect_power(const BigInteger& value) {
+    BigInteger magnitude = value.is_negative() ? -value : value;
+    if (magnitude <= 1) return true;
+
+    // it is enough to check prime exponents, the roots decrease with the exponent
+    for (auto prime : primes_up_to(4 * magnitude.size())) {
+        if (value.is_negative() && prime == 2) continue;
+        BigInteger root = root_of_non_negative(magnitude, prime);
+        if (root <= 1) break;
+        if (BigInteger::power(root, prime) == magnitude) return true;
+    }
+    return false;
+}
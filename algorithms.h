@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <future>
+#include <span>
+
+#include "biginteger.h"
+#include "exceptions.h"
+
+// Balanced recursive algorithms over many integers at once
+
+// runs action(i) for every i in [0, count) on threads_count threads
+template<typename Action>
+void parallel_for(size_t count, size_t threads_count, const Action& action) {
+    if (threads_count == 0) throw InvalidArgumentException("0 threads", "at least one thread");
+    size_t part = (count + threads_count - 1) / threads_count;
+    auto run_part = [&action, count](size_t begin, size_t end) {
+        for (size_t i = begin; i < std::min(end, count); ++i) {
+            action(i);
+        }
+    };
+
+    vector<std::future<void>> parts;
+    for (size_t begin = part; begin < count; begin += part) {
+        parts.push_back(std::async(std::launch::async, run_part, begin, begin + part));
+    }
+    run_part(0, part);
+    for (auto& future : parts) {
+        future.get();
+    }
+}
+
+// product of all the values (1 for no values), neighbours are multiplied level by level,
+// so the operands of every multiplication have close sizes; levels run on threads_count threads
+BigInteger product_tree(std::span<const BigInteger> values, size_t threads_count=1);
+
+// value % moduli[i] for every i (with the sign of value, as operator%),
+// value is reduced by the products of the moduli from the root of the product tree down to the leaves
+vector<BigInteger> remainder_tree(const BigInteger& value, std::span<const BigInteger> moduli, size_t threads_count=1);
+
+// n!, computed as (n / 2)!^2 * swing(n) where the prime factorization of the swing
+// (Luschny's prime swing, n! / (n / 2)!^2) is taken from a sieve and multiplied by a product tree
+BigInteger factorial(unsigned long long n);
+
+// n! / (k! * (n - k)!), 0 for k > n; the prime factorization follows from Kummer's theorem
+BigInteger binomial(unsigned long long n, unsigned long long k);
+
+// product of all the primes not greater than n
+BigInteger primorial(unsigned long long n);
+
+// floor(sqrt(value)), value must be non-negative
+BigInteger isqrt(const BigInteger& value);
+
+// root = isqrt(value), remainder = value - root^2
+void isqrt_rem(const BigInteger& value, BigInteger& root, BigInteger& remainder);
+
+// value^(1 / degree) rounded towards zero, negative values are allowed only for odd degrees.
+// Newton iteration starts from the root of the leading half of the digits (computed recursively),
+// so every level costs a few divisions of the current size
+BigInteger iroot(const BigInteger& value, unsigned long long degree);
+
+// checks that value = base^exponent for some integer base and exponent >= 2
+bool is_perfect_power(const BigInteger& value);
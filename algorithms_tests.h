@@ -0,0 +1,212 @@
+#pragma once
+
+#include "bigint_test_helper.h"
+#include "algorithms.h"
+
+BigInteger fold_product(const vector<BigInteger>& values) {
+    BigInteger result = 1;
+    for (const auto& value : values) {
+        result *= value;
+    }
+    return result;
+}
+
+TEST(AlgorithmsTests, ProductTree) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        vector<BigInteger> values;
+        for (int j = 0; j <= i; ++j) {
+            values.push_back(random_bigint(1 + random_value() % 30) * (j % 3 == 0 ? -1 : 1));
+        }
+        ASSERT_EQ(fold_product(values), product_tree(values));
+    }
+}
+
+TEST(AlgorithmsTests, ProductTreeEmpty) {
+    ASSERT_EQ(1, product_tree({}));
+}
+
+TEST(AlgorithmsTests, ProductTreeZero) {
+    vector<BigInteger> values = {179, -57, 0, 1791791791};
+    BigInteger product = product_tree(values);
+    ASSERT_EQ(0, product);
+    ASSERT_FALSE(product.is_negative());
+}
+
+TEST(AlgorithmsTests, ProductTreeThreads) {
+    vector<BigInteger> values;
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(random_bigint(20));
+    }
+    ASSERT_EQ(fold_product(values), product_tree(values, 4));
+}
+
+TEST(AlgorithmsTests, RemainderTree) {
+    vector<BigInteger> moduli;
+    for (int i = 0; i < 37; ++i) {
+        moduli.push_back(random_bigint(1 + random_value() % 15) + 1);
+    }
+    BigInteger value = random_bigint(300);
+    vector<BigInteger> remainders = remainder_tree(value, moduli, 3);
+    ASSERT_EQ(moduli.size(), remainders.size());
+    for (size_t i = 0; i < moduli.size(); ++i) {
+        ASSERT_EQ(value % moduli[i], remainders[i]) << i;
+    }
+}
+
+TEST(AlgorithmsTests, RemainderTreeNegative) {
+    vector<BigInteger> moduli = {7, -10, 13, 1};
+    vector<BigInteger> remainders = remainder_tree(-1791791791, moduli);
+    ASSERT_EQ(vector<BigInteger>({-1791791791 % 7, -1, -1791791791 % 13, 0}), remainders);
+}
+
+TEST(AlgorithmsTests, RemainderTreeEdgeCases) {
+    ASSERT_TRUE(remainder_tree(179, {}).empty());
+    vector<BigInteger> moduli = {3, 0};
+    ASSERT_THROW(remainder_tree(179, moduli), DivisionByZeroException);
+}
+
+TEST(AlgorithmsTests, Factorial) {
+    BigInteger expected = 1;
+    for (unsigned long long n = 0; n < 300; ++n) {
+        if (n > 0) expected *= n;
+        ASSERT_EQ(expected, factorial(n)) << n;
+    }
+}
+
+TEST(AlgorithmsTests, FactorialKnown) {
+    ASSERT_EQ(BigInteger("15511210043330985984000000"), factorial(25));
+    BigInteger big = factorial(10'000);
+    ASSERT_EQ(35'660, big.size());
+    ASSERT_EQ(BigInteger("28462596809170545189"), BigInteger(big.toString().substr(0, 20)));
+}
+
+TEST(AlgorithmsTests, Binomial) {
+    vector<BigInteger> row = {1};
+    for (unsigned long long n = 0; n < 120; ++n) {
+        for (unsigned long long k = 0; k <= n; ++k) {
+            ASSERT_EQ(row[k], binomial(n, k)) << n << " " << k;
+        }
+        ASSERT_EQ(0, binomial(n, n + 1));
+        vector<BigInteger> next(row.size() + 1, 0);
+        for (size_t k = 0; k < row.size(); ++k) {
+            next[k] += row[k];
+            next[k + 1] += row[k];
+        }
+        row = std::move(next);
+    }
+}
+
+TEST(AlgorithmsTests, BinomialBig) {
+    ASSERT_EQ(factorial(3000) / (factorial(1000) * factorial(2000)), binomial(3000, 1000));
+    ASSERT_EQ(BigInteger("499999500000"), binomial(1'000'000, 2));
+    ASSERT_EQ(1, binomial(1'000'000'000'000, 0));
+    ASSERT_EQ(2'000'000'000, binomial(2'000'000'000, 1));
+    ASSERT_EQ(BigInteger("166666666666166666666667000000000000"), binomial(1'000'000'000'000, 3));
+    BigInteger falling = 1;
+    for (unsigned long long i = 0; i < 30; ++i) {
+        falling *= 1'000'000'000'000'000'000 - i;
+    }
+    ASSERT_EQ(falling / factorial(30), binomial(1'000'000'000'000'000'000, 30));
+}
+
+TEST(AlgorithmsTests, Primorial) {
+    ASSERT_EQ(1, primorial(0));
+    ASSERT_EQ(1, primorial(1));
+    ASSERT_EQ(2, primorial(2));
+    ASSERT_EQ(BigInteger("6469693230"), primorial(30));
+    ASSERT_EQ(primorial(30) * 31, primorial(36));
+}
+
+void check_root(const BigInteger& value, unsigned long long degree, const BigInteger& root) {
+    ASSERT_LE(BigInteger::power(root, degree), value);
+    ASSERT_GT(BigInteger::power(root + 1, degree), value);
+}
+
+TEST(AlgorithmsTests, Isqrt) {
+    for (long long value = 0; value < 1000; ++value) {
+        check_root(value, 2, isqrt(value));
+    }
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger value = random_bigint(1 + 50 * i);
+        check_root(value, 2, isqrt(value));
+    }
+}
+
+TEST(AlgorithmsTests, IsqrtExact) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger root = random_bigint(1 + 30 * i);
+        ASSERT_EQ(root, isqrt(root * root));
+        ASSERT_EQ(root - 1, isqrt(root * root - 1));
+    }
+}
+
+TEST(AlgorithmsTests, IsqrtRem) {
+    BigInteger root;
+    BigInteger remainder;
+    isqrt_rem(BigInteger::power(10, 100) + 179, root, remainder);
+    ASSERT_EQ(BigInteger::power(10, 50), root);
+    ASSERT_EQ(179, remainder);
+
+    BigInteger value = 1791791791;
+    isqrt_rem(value, value, remainder);
+    ASSERT_EQ(42329, value);
+    ASSERT_EQ(1791791791 - 42329ll * 42329, remainder);
+}
+
+TEST(AlgorithmsTests, IsqrtNegative) {
+    ASSERT_THROW(isqrt(-1), InvalidArgumentException);
+}
+
+TEST(AlgorithmsTests, Iroot) {
+    for (unsigned long long degree = 1; degree < 12; ++degree) {
+        for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+            BigInteger value = random_bigint(1 + 7 * i);
+            check_root(value, degree, iroot(value, degree));
+        }
+    }
+}
+
+TEST(AlgorithmsTests, IrootExact) {
+    BigInteger base = random_bigint(40);
+    for (unsigned long long degree = 1; degree < 20; ++degree) {
+        BigInteger value = BigInteger::power(base, degree);
+        ASSERT_EQ(base, iroot(value, degree));
+        ASSERT_EQ(base - 1, iroot(value - 1, degree));
+    }
+}
+
+TEST(AlgorithmsTests, IrootNineteenDigits) {
+    BigInteger value("9915496506904955722");
+    check_root(value, 2, iroot(value, 2));
+    check_root(value, 3, iroot(value, 3));
+}
+
+TEST(AlgorithmsTests, IrootLargeDegree) {
+    BigInteger value = BigInteger::power(3, 500);
+    ASSERT_EQ(3, iroot(value, 500));
+    ASSERT_EQ(2, iroot(value, 501));
+    ASSERT_EQ(1, iroot(value, 800));
+    ASSERT_EQ(1, iroot(value, 1'000'000));
+}
+
+TEST(AlgorithmsTests, IrootNegative) {
+    ASSERT_EQ(-5, iroot(-125, 3));
+    ASSERT_EQ(-4, iroot(-124, 3));
+    ASSERT_THROW(iroot(-125, 2), InvalidArgumentException);
+    ASSERT_THROW(iroot(125, 0), InvalidArgumentException);
+}
+
+TEST(AlgorithmsTests, IsPerfectPower) {
+    ASSERT_TRUE(is_perfect_power(0));
+    ASSERT_TRUE(is_perfect_power(1));
+    ASSERT_TRUE(is_perfect_power(-1));
+    ASSERT_TRUE(is_perfect_power(4));
+    ASSERT_TRUE(is_perfect_power(-8));
+    ASSERT_FALSE(is_perfect_power(-4));
+    ASSERT_FALSE(is_perfect_power(2));
+    ASSERT_FALSE(is_perfect_power(1791791791));
+    ASSERT_TRUE(is_perfect_power(BigInteger::power(179, 57)));
+    ASSERT_TRUE(is_perfect_power(BigInteger::power(10, 91)));
+    ASSERT_FALSE(is_perfect_power(BigInteger::power(10, 91) + 1));
+    ASSERT_FALSE(is_perfect_power(BigInteger::power(2, 127) - 1));
+}
@@ -0,0 +1,492 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <sstream>
+
+#include "algorithms.h"
+#include "biginteger.h"
+#include "fixedint.h"
+#include "modular.h"
+#include "primes.h"
+#include "rational.h"
+#include "sharedbiginteger.h"
+
+// Every benchmark takes the size of operands (in decimal digits) as its argument
+// and reports digits per second as throughput together with allocations per operation.
+// Linear operations go up to 10^7 digits, the others stop where one iteration
+// would take more than a few seconds.
+
+static size_t allocations_count = 0;
+static size_t allocated_bytes = 0;
+
+void* operator new(size_t size) {
+    ++allocations_count;
+    allocated_bytes += size;
+    void* p = malloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+std::mt19937 bench_random(1791791791);
+
+BigInteger random_bigint(size_t size) {
+    BigInteger lowest = 1;
+    lowest.shift(size - 1);
+    return lowest + BigInteger::random_below(bench_random, lowest * 9);
+}
+
+Rational random_rational(size_t size) {
+    Rational result = random_bigint(size);
+    return result /= random_bigint(size);
+}
+
+class AllocationCounter {
+  private:
+    benchmark::State& state;
+    size_t allocations_at_start;
+    size_t bytes_at_start;
+  public:
+    AllocationCounter(benchmark::State& state)
+        : state(state)
+        , allocations_at_start(allocations_count)
+        , bytes_at_start(allocated_bytes) {}
+
+    ~AllocationCounter() {
+        state.counters["allocs_per_op"] = benchmark::Counter(
+            allocations_count - allocations_at_start, benchmark::Counter::kAvgIterations);
+        state.counters["alloc_bytes_per_op"] = benchmark::Counter(
+            allocated_bytes - bytes_at_start, benchmark::Counter::kAvgIterations);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+};
+
+#define BIGINT_BINARY_BENCHMARK(name, op, left_size, right_size) \
+    void name(benchmark::State& state) { \
+        BigInteger left = random_bigint(left_size); \
+        BigInteger right = random_bigint(right_size); \
+        AllocationCounter counter(state); \
+        for (auto _ : state) { \
+            benchmark::DoNotOptimize(left op right); \
+        } \
+    }
+
+BIGINT_BINARY_BENCHMARK(BM_Add, +, state.range(0), state.range(0))
+BIGINT_BINARY_BENCHMARK(BM_Sub, -, state.range(0), state.range(0))
+BIGINT_BINARY_BENCHMARK(BM_Mul, *, state.range(0), state.range(0))
+BIGINT_BINARY_BENCHMARK(BM_Div, /, 2 * state.range(0), state.range(0))
+BIGINT_BINARY_BENCHMARK(BM_Mod, %, 2 * state.range(0), state.range(0))
+BIGINT_BINARY_BENCHMARK(BM_Compare, <=>, state.range(0), state.range(0))
+BIGINT_BINARY_BENCHMARK(BM_And, &, state.range(0), state.range(0))
+BIGINT_BINARY_BENCHMARK(BM_Xor, ^, state.range(0), state.range(0))
+
+void BM_BitLength(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value.bit_length());
+    }
+}
+
+// accumulator of twice the size, as in BM_Mul followed by BM_Add
+void BM_Addmul(benchmark::State& state) {
+    BigInteger accumulator = random_bigint(2 * state.range(0));
+    BigInteger left = random_bigint(state.range(0));
+    BigInteger right = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        BigInteger::addmul(accumulator, left, right);
+    }
+}
+
+void BM_AddmulWord(benchmark::State& state) {
+    BigInteger accumulator = random_bigint(state.range(0) + 20);
+    BigInteger value = random_bigint(state.range(0));
+    long long multiplier = 1 + bench_random();
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        BigInteger::addmul_1(accumulator, value, multiplier);
+    }
+}
+
+// the same sizes as BM_Div, but the dividend is a multiple of the divisor
+void BM_Divexact(benchmark::State& state) {
+    BigInteger divisor = random_bigint(state.range(0));
+    BigInteger dividend = divisor * random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BigInteger::divexact(dividend, divisor));
+    }
+}
+
+void BM_DivisibleBy(benchmark::State& state) {
+    BigInteger divisor = random_bigint(state.range(0));
+    BigInteger dividend = divisor * random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BigInteger::divisible_by(dividend, divisor));
+    }
+}
+
+// the same number of products as BM_Mul makes in 1000 iterations
+void BM_MultiplyBatch(benchmark::State& state) {
+    const size_t batch_size = 1000;
+    vector<BigInteger> left;
+    vector<BigInteger> right;
+    for (size_t i = 0; i < batch_size; ++i) {
+        left.push_back(random_bigint(state.range(0)));
+        right.push_back(random_bigint(state.range(0)));
+    }
+    vector<BigInteger> result(batch_size);
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        BigInteger::multiply_batch(left, right, result);
+    }
+}
+
+void BM_ProductTree(benchmark::State& state) {
+    vector<BigInteger> values;
+    for (size_t i = 0; i < 1000; ++i) {
+        values.push_back(random_bigint(state.range(0)));
+    }
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(product_tree(values));
+    }
+}
+
+void BM_RemainderTree(benchmark::State& state) {
+    vector<BigInteger> moduli;
+    for (size_t i = 0; i < 1000; ++i) {
+        moduli.push_back(random_bigint(state.range(0)));
+    }
+    BigInteger value = random_bigint(1000 * state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(remainder_tree(value, moduli));
+    }
+}
+
+// the argument is n, not the size
+void BM_Factorial(benchmark::State& state) {
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(factorial(state.range(0)));
+    }
+}
+
+void BM_Isqrt(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(isqrt(value));
+    }
+}
+
+void BM_NextPrime(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(next_prime(value));
+    }
+}
+
+#define BIGINT_WORD_BENCHMARK(name, op) \
+    void name(benchmark::State& state) { \
+        BigInteger left = random_bigint(state.range(0)); \
+        long long right = 1 + bench_random(); \
+        AllocationCounter counter(state); \
+        for (auto _ : state) { \
+            benchmark::DoNotOptimize(left op right); \
+        } \
+    }
+
+BIGINT_WORD_BENCHMARK(BM_AddWord, +)
+BIGINT_WORD_BENCHMARK(BM_MulWord, *)
+BIGINT_WORD_BENCHMARK(BM_DivWord, /)
+BIGINT_WORD_BENCHMARK(BM_ModWord, %)
+
+void BM_AddInPlace(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    BigInteger other = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        value += other;
+    }
+}
+
+void BM_Increment(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        ++value;
+    }
+}
+
+void BM_Gcd(benchmark::State& state) {
+    BigInteger left = random_bigint(state.range(0));
+    BigInteger right = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gcd(left, right));
+    }
+}
+
+void BM_Power(benchmark::State& state) {
+    BigInteger indicator = 1 + bench_random() % 1000;
+    BigInteger exponent = state.range(0);
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BigInteger::power(indicator, exponent));
+    }
+}
+
+void BM_Powmod(benchmark::State& state) {
+    BigInteger modulus = random_bigint(state.range(0)) * 10 + 7;
+    BigInteger base = random_bigint(state.range(0));
+    BigInteger exponent = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(powmod(base, exponent, modulus));
+    }
+}
+
+void BM_Shift(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        value.shift(1);
+        value.shift(-1);
+    }
+}
+
+void BM_ToString(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value.toString());
+    }
+}
+
+void BM_Parse(benchmark::State& state) {
+    string value = random_bigint(state.range(0)).toString();
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BigInteger(value));
+    }
+}
+
+void BM_ToChars(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    vector<char> buffer(formatted_size(value));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(to_chars(buffer.data(), buffer.data() + buffer.size(), value));
+    }
+}
+
+void BM_FromChars(benchmark::State& state) {
+    string source = random_bigint(state.range(0)).toString();
+    BigInteger value = 0;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(from_chars(source.data(), source.data() + source.size(), value));
+    }
+}
+
+void BM_ToStringHex(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value.toString(16));
+    }
+}
+
+void BM_ParseHex(benchmark::State& state) {
+    string value = random_bigint(state.range(0)).toString(16);
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BigInteger(value, 16));
+    }
+}
+
+void BM_Output(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    std::ostringstream output;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        output.seekp(0);
+        output << value;
+    }
+}
+
+// operands of a half of Fixed's width, so that the product doesn't wrap
+#define FIXED_BINARY_BENCHMARK(name, op) \
+    template<typename Fixed> \
+    void name(benchmark::State& state) { \
+        size_t digits = Fixed::LIMBS_COUNT * 64 * 3 / 10 / 2; \
+        Fixed left = Fixed(random_bigint(2 * digits)); \
+        Fixed right = Fixed(random_bigint(digits)); \
+        AllocationCounter counter(state); \
+        for (auto _ : state) { \
+            benchmark::DoNotOptimize(left op right); \
+        } \
+    }
+
+FIXED_BINARY_BENCHMARK(BM_FixedAdd, +)
+FIXED_BINARY_BENCHMARK(BM_FixedMul, *)
+FIXED_BINARY_BENCHMARK(BM_FixedDiv, /)
+
+void BM_LongLongConstructor(benchmark::State& state) {
+    long long value = bench_random();
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(BigInteger(value));
+    }
+}
+
+void BM_RandomBelow(benchmark::State& state) {
+    BigInteger bound = random_bigint(state.range(0));
+    std::mt19937_64 generator(57);
+    BigInteger value;
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        BigInteger::random_below(generator, bound, std::span<BigInteger>(&value, 1));
+        benchmark::DoNotOptimize(value);
+    }
+}
+
+void BM_Hash(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::hash<BigInteger>()(value));
+    }
+}
+
+void BM_Copy(benchmark::State& state) {
+    BigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        BigInteger copy = value;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+void BM_SharedCopy(benchmark::State& state) {
+    SharedBigInteger value = random_bigint(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        SharedBigInteger copy = value;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+#define RATIONAL_BINARY_BENCHMARK(name, op) \
+    void name(benchmark::State& state) { \
+        Rational left = random_rational(state.range(0)); \
+        Rational right = random_rational(state.range(0)); \
+        AllocationCounter counter(state); \
+        for (auto _ : state) { \
+            benchmark::DoNotOptimize(left op right); \
+        } \
+    }
+
+RATIONAL_BINARY_BENCHMARK(BM_RationalAdd, +)
+RATIONAL_BINARY_BENCHMARK(BM_RationalSub, -)
+RATIONAL_BINARY_BENCHMARK(BM_RationalMul, *)
+RATIONAL_BINARY_BENCHMARK(BM_RationalDiv, /)
+RATIONAL_BINARY_BENCHMARK(BM_RationalCompare, <=>)
+
+void BM_RationalAsDecimal(benchmark::State& state) {
+    Rational value = random_rational(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value.asDecimal(20));
+    }
+}
+
+void BM_RationalToDouble(benchmark::State& state) {
+    Rational value = random_rational(state.range(0));
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(static_cast<double>(value));
+    }
+}
+
+void BM_RationalFromDouble(benchmark::State& state) {
+    std::uniform_real_distribution<double> distribution(-1e10, 1e10);
+    double value = distribution(bench_random);
+    AllocationCounter counter(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Rational(value));
+    }
+}
+
+const long long LINEAR_LIMIT = 10'000'000;
+const long long FFT_LIMIT = 1'000'000;
+const long long QUADRATIC_LIMIT = 10'000;
+const long long RATIONAL_LIMIT = 1'000;
+// cubic in the size
+const long long POWMOD_LIMIT = 100;
+// divides 1000 times longer values than the moduli
+const long long REMAINDER_TREE_LIMIT = 10;
+const long long FACTORIAL_LIMIT = 1'000'000;
+
+BENCHMARK(BM_Add)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_Sub)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_AddWord)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_MulWord)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_DivWord)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_ModWord)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_AddInPlace)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_Increment)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_Compare)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_Mul)->RangeMultiplier(10)->Range(1, FFT_LIMIT);
+BENCHMARK(BM_MultiplyBatch)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_ProductTree)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_RemainderTree)->RangeMultiplier(10)->Range(1, REMAINDER_TREE_LIMIT);
+BENCHMARK(BM_Factorial)->RangeMultiplier(10)->Range(1, FACTORIAL_LIMIT);
+BENCHMARK(BM_Isqrt)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_NextPrime)->RangeMultiplier(10)->Range(1, POWMOD_LIMIT);
+BENCHMARK(BM_Div)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_Mod)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_Addmul)->RangeMultiplier(10)->Range(1, FFT_LIMIT);
+BENCHMARK(BM_AddmulWord)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_And)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_Xor)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_BitLength)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_Divexact)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_DivisibleBy)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_Gcd)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_Power)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_Powmod)->RangeMultiplier(10)->Range(1, POWMOD_LIMIT);
+BENCHMARK(BM_Shift)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_ToString)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_Parse)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_Output)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_ToStringHex)->RangeMultiplier(10)->Range(1, QUADRATIC_LIMIT);
+BENCHMARK(BM_ParseHex)->RangeMultiplier(10)->Range(1, FFT_LIMIT);
+BENCHMARK(BM_ToChars)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_FromChars)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_LongLongConstructor)->Arg(1);
+BENCHMARK(BM_RandomBelow)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_Hash)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_Copy)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK(BM_SharedCopy)->RangeMultiplier(10)->Range(1, LINEAR_LIMIT);
+BENCHMARK_TEMPLATE(BM_FixedAdd, UInt256)->Arg(1);
+BENCHMARK_TEMPLATE(BM_FixedMul, UInt256)->Arg(1);
+BENCHMARK_TEMPLATE(BM_FixedDiv, UInt256)->Arg(1);
+BENCHMARK_TEMPLATE(BM_FixedAdd, Int512)->Arg(1);
+BENCHMARK_TEMPLATE(BM_FixedMul, Int512)->Arg(1);
+BENCHMARK_TEMPLATE(BM_FixedDiv, Int512)->Arg(1);
+BENCHMARK(BM_RationalAdd)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_RationalSub)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_RationalMul)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_RationalDiv)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_RationalCompare)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_RationalAsDecimal)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_RationalToDouble)->RangeMultiplier(10)->Range(1, RATIONAL_LIMIT);
+BENCHMARK(BM_RationalFromDouble)->Arg(1);
+
+BENCHMARK_MAIN();
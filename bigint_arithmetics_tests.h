@@ -26,6 +26,18 @@ TEST(BiOperatorTests, MultMemory) {
     CHECK_OPERATOR_ALLOCATIONS(*, 3);
 }
 
+TEST(BiOperatorTests, MultUncachedPlan) {
+    // transforms of 2^19 points take plans which are not cached, the second product builds its plan again
+    BigInteger a = random_bigint(150000);
+    BigInteger b = random_bigint(150000);
+    for (int i = 0; i < 2; ++i) {
+        BigInteger product = a * b;
+        ASSERT_EQ((a % 1'000'000'007) * (b % 1'000'000'007) % 1'000'000'007, product % 1'000'000'007);
+        ASSERT_EQ(a % 999'999'937 * (b % 999'999'937) % 999'999'937, product % 999'999'937);
+        b += 1;
+    }
+}
+
 TEST(BiOperatorTests, DivRandom) {
     TEST_SAME_OPERATOR(/, /=);
 }
@@ -172,6 +184,65 @@ TEST(BiOperatorTests, TimesEQRandom) {
     }
 }
 
+TEST(BiOperatorTests, TimesEQBig) {
+    // the product is checked modulo a prime, which has to catch rounding errors of the transform
+    BigInteger prime = 1'000'000'007;
+    auto first = random_bigint(300'000);
+    auto second = random_bigint(200'000);
+    auto expected = (first % prime) * (second % prime) % prime;
+    first *= second;
+    // a product of numbers of n and m digits has n + m - 1 or n + m digits
+    ASSERT_GE(first.size(), 499'999);
+    ASSERT_LE(first.size(), 500'000);
+    ASSERT_EQ(expected, first % prime);
+}
+
+TEST(BiMethodsTests, MultiplyBatch) {
+    vector<BigInteger> left;
+    vector<BigInteger> right;
+    for (int i = 0; i < 3 * RANDOM_TRIES_COUNT; ++i) {
+        left.push_back(random_bigint(1 + random_value() % 200) * (i % 3 == 0 ? -1 : 1));
+        right.push_back(random_bigint(1 + random_value() % 200) * (i % 4 == 0 ? -1 : 1));
+    }
+    left.push_back(0);
+    right.push_back(-179);
+
+    vector<BigInteger> result(left.size());
+    BigInteger::multiply_batch(left, right, result);
+    for (size_t i = 0; i < left.size(); ++i) {
+        ASSERT_EQ(left[i] * right[i], result[i]) << i;
+    }
+    ASSERT_FALSE(result.back().is_negative());
+}
+
+TEST(BiMethodsTests, MultiplyBatchThreads) {
+    vector<BigInteger> left;
+    vector<BigInteger> right;
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        left.push_back(random_bigint(500));
+        right.push_back(random_bigint(500));
+    }
+
+    vector<BigInteger> result(left.size());
+    BigInteger::multiply_batch(left, right, result, 3);
+    for (size_t i = 0; i < left.size(); ++i) {
+        ASSERT_EQ(left[i] * right[i], result[i]) << i;
+    }
+}
+
+TEST(BiMethodsTests, MultiplyBatchAliasing) {
+    vector<BigInteger> values = {12, -34, 56};
+    BigInteger::multiply_batch(values, values, values);
+    ASSERT_EQ(vector<BigInteger>({144, 1156, 3136}), values);
+}
+
+TEST(BiMethodsTests, MultiplyBatchSizeMismatch) {
+    vector<BigInteger> left(2);
+    vector<BigInteger> result(3);
+    ASSERT_THROW(BigInteger::multiply_batch(left, left, result), InvalidArgumentException);
+    ASSERT_THROW(BigInteger::multiply_batch(left, left, std::span<BigInteger>(result).first(2), 0), InvalidArgumentException);
+}
+
 TEST(BiOperatorTests, TimesEQTime) {
     int total_time = 0;
     int time_treshold = 3000;
@@ -244,6 +315,167 @@ TEST(BiOperatorTests, DivEqMemory) {
     CHECK_OPERATOR_ALLOCATIONS(/=, 1);
 }
 
+TEST(BiMethodsTests, Divexact) {
+    // short and long divisors, with and without factors of 2 and 5, quotients below and above the inverse limit
+    for (size_t divisor_size : {5, 30, 200, 1500}) {
+        for (size_t quotient_size : {1, 40, 1200}) {
+            BigInteger divisor = random_bigint(divisor_size);
+            BigInteger quotient = random_bigint(quotient_size);
+            ASSERT_EQ(quotient, BigInteger::divexact(quotient * divisor, divisor));
+            ASSERT_EQ(quotient, BigInteger::divexact(quotient * divisor * 1024, divisor * 1024));
+            ASSERT_EQ(quotient, BigInteger::divexact(quotient * divisor * 3125, divisor * 3125));
+            ASSERT_EQ(quotient * 7, BigInteger::divexact(quotient * divisor * 7000, divisor * 1000));
+        }
+    }
+}
+
+TEST(BiMethodsTests, DivexactLong) {
+    // long enough for the inverse modulo a power of ten
+    BigInteger divisor = random_bigint(16000) * 10 + 3;
+    BigInteger quotient = random_bigint(16000);
+    BigInteger multiple = quotient * divisor;
+    ASSERT_EQ(quotient, BigInteger::divexact(multiple, divisor));
+    ASSERT_TRUE(BigInteger::divisible_by(multiple, divisor));
+    ASSERT_FALSE(BigInteger::divisible_by(multiple + divisor / 2, divisor));
+}
+
+TEST(BiMethodsTests, Addmul) {
+    // digit by digit and through the transform
+    for (size_t size : {1, 20, 150, 500}) {
+        for (int i = 0; i < 4; ++i) {
+            BigInteger accumulator = random_bigint(size + 30);
+            BigInteger left = random_bigint(size);
+            BigInteger right = random_bigint(size + 7);
+            if (i & 1) left.invert_sign();
+            if (i & 2) accumulator.invert_sign();
+            BigInteger expected = accumulator + left * right;
+            BigInteger::addmul(accumulator, left, right);
+            ASSERT_EQ(expected, accumulator);
+        }
+    }
+}
+
+TEST(BiMethodsTests, AddmulLopsided) {
+    // a short operand of a long one goes digit by digit, operands of the same length through the transform
+    for (auto [left_size, right_size] : vector<std::pair<size_t, size_t>>{{40, 100000}, {10000, 10000}}) {
+        BigInteger accumulator = random_bigint(right_size);
+        BigInteger left = random_bigint(left_size);
+        BigInteger right = random_bigint(right_size);
+        left.invert_sign();
+        BigInteger expected = accumulator + left * right;
+        BigInteger::addmul(accumulator, left, right);
+        ASSERT_EQ(expected, accumulator);
+    }
+}
+
+TEST(BiMethodsTests, Submul) {
+    for (size_t size : {1, 20, 150, 500}) {
+        for (int i = 0; i < 4; ++i) {
+            // the product is both shorter and longer than the accumulator
+            BigInteger accumulator = random_bigint(2 * size + (i & 1 ? 5 : -1));
+            BigInteger left = random_bigint(size);
+            BigInteger right = random_bigint(size);
+            if (i & 2) right.invert_sign();
+            BigInteger expected = accumulator - left * right;
+            BigInteger::submul(accumulator, left, right);
+            ASSERT_EQ(expected, accumulator);
+        }
+    }
+}
+
+TEST(BiMethodsTests, AddmulCancellation) {
+    BigInteger left = random_bigint(40);
+    BigInteger right = random_bigint(30);
+    BigInteger accumulator = left * right;
+    BigInteger::submul(accumulator, left, right);
+    ASSERT_EQ(0, accumulator);
+    ASSERT_FALSE(accumulator.is_negative());
+    BigInteger::addmul(accumulator, left, -right);
+    ASSERT_EQ(-(left * right), accumulator);
+    BigInteger::addmul(accumulator, left, 0);
+    ASSERT_EQ(-(left * right), accumulator);
+}
+
+TEST(BiMethodsTests, AddmulAliasing) {
+    BigInteger a = 179;
+    BigInteger::addmul(a, a, a);
+    ASSERT_EQ(179 + 179 * 179, a);
+    BigInteger::submul(a, a, 2);
+    ASSERT_EQ(-(179 + 179 * 179), a);
+    BigInteger b = 57;
+    BigInteger::addmul_1(b, b, 3);
+    ASSERT_EQ(57 * 4, b);
+}
+
+TEST(BiMethodsTests, AddmulWord) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger accumulator = random_bigint(30);
+        BigInteger value = random_bigint(25);
+        long long multiplier = random_value();
+        BigInteger expected = accumulator + value * BigInteger(multiplier);
+        BigInteger::addmul_1(accumulator, value, multiplier);
+        ASSERT_EQ(expected, accumulator);
+        expected -= value * BigInteger(multiplier);
+        BigInteger::submul_1(accumulator, value, multiplier);
+        ASSERT_EQ(expected, accumulator);
+    }
+}
+
+TEST(BiMethodsTests, AddmulWordLimits) {
+    BigInteger value = BigInteger("123456789012345678901234567890");
+    for (auto multiplier : {std::numeric_limits<unsigned long long>::max(), 1'000'000'000'000'000'000ull, 999'999'999'999'999'999ull}) {
+        BigInteger accumulator = -1;
+        BigInteger::addmul_1(accumulator, value, multiplier);
+        ASSERT_EQ(value * BigInteger(multiplier) - 1, accumulator);
+    }
+    BigInteger accumulator = 0;
+    BigInteger::submul_1(accumulator, value, std::numeric_limits<long long>::min());
+    ASSERT_EQ(-(value * BigInteger(std::numeric_limits<long long>::min())), accumulator);
+}
+
+TEST(BiMethodsTests, AddmulNoAllocations) {
+    BigInteger accumulator = random_bigint(300);
+    BigInteger left = random_bigint(100);
+    BigInteger right = random_bigint(150);
+    accumulator.shift(10);
+    accumulator.shift(-10);
+    OperatorNewCounter cntr(true);
+    BigInteger::addmul(accumulator, left, right);
+    BigInteger::submul(accumulator, right, left);
+    BigInteger::addmul_1(accumulator, left, 1791791791);
+    BigInteger::submul_1(accumulator, left, -57);
+    ASSERT_EQ(0, cntr.get_counter());
+}
+
+TEST(BiMethodsTests, DivexactSigns) {
+    BigInteger divisor = BigInteger("123456789012345678901234567");
+    BigInteger quotient = BigInteger("-98765432109876543210");
+    ASSERT_EQ(quotient, BigInteger::divexact(quotient * divisor, divisor));
+    ASSERT_EQ(-quotient, BigInteger::divexact(quotient * divisor, -divisor));
+    ASSERT_EQ(quotient, BigInteger::divexact(-quotient * divisor, -divisor));
+    ASSERT_EQ(-5, BigInteger::divexact(-35, 7));
+    ASSERT_EQ(0, BigInteger::divexact(0, divisor));
+    ASSERT_FALSE(BigInteger::divexact(0, -divisor).is_negative());
+    ASSERT_THROW(BigInteger::divexact(35, 0), DivisionByZeroException);
+}
+
+TEST(BiMethodsTests, DivisibleBy) {
+    for (size_t size : {5, 30, 1500}) {
+        BigInteger divisor = random_bigint(size);
+        BigInteger multiple = divisor * (random_bigint(1200) * 10 + 1);
+        ASSERT_TRUE(BigInteger::divisible_by(multiple, divisor));
+        ASSERT_TRUE(BigInteger::divisible_by(-multiple, divisor));
+        ASSERT_FALSE(BigInteger::divisible_by(multiple + 1, divisor));
+        ASSERT_TRUE(BigInteger::divisible_by(multiple * 80, divisor * 16));
+        ASSERT_FALSE(BigInteger::divisible_by(multiple * 80, divisor * 32));
+        ASSERT_FALSE(BigInteger::divisible_by(multiple * 10, divisor * 100));
+        ASSERT_EQ(BigInteger::divisible_by(multiple, divisor + 2), (multiple % (divisor + 2)).is_zero());
+    }
+    ASSERT_TRUE(BigInteger::divisible_by(0, 179));
+    ASSERT_FALSE(BigInteger::divisible_by(57, BigInteger("179179179179179179179179")));
+    ASSERT_THROW(BigInteger::divisible_by(35, 0), DivisionByZeroException);
+}
+
 void test_modulus(long long left, long long right) {
     BigInteger a = left;
     a %= right;
@@ -482,6 +714,20 @@ TEST(BiMethodsTests, ZeroPower) {
     ASSERT_EQ(0, a);
 }
 
+TEST(BiMethodsTests, PowerMinusOne) {
+    ASSERT_EQ(-1, BigInteger::power(-1, 1791791791));
+    ASSERT_EQ(1, BigInteger::power(-1, 1791791790));
+}
+
+TEST(BiMethodsTests, PowerRepeated) {
+    BigInteger base = random_bigint(5);
+    BigInteger expected = 1;
+    for (int exponent = 0; exponent < 123; ++exponent) {
+        ASSERT_EQ(expected, BigInteger::power(base, exponent));
+        expected *= base;
+    }
+}
+
 TEST(BiMethodsTests, PowerTime) {
     int time_treshold = 2500;
     int total_time = 0;
@@ -617,3 +863,235 @@ TEST(BiMethodsTests, ShiftTime) {
     }
 }
 
+
+TEST(BiMethodsTests, ShiftNegativeDigits) {
+    BigInteger a = -17900;
+    a.shift(-3);
+    ASSERT_EQ(-17, a);
+}
+
+TEST(BiMethodsTests, ShiftNegativeToZero) {
+    BigInteger a = -179;
+    a.shift(-5);
+    ASSERT_EQ(0, a);
+    ASSERT_FALSE(a.is_negative());
+}
+
+void test_divmod(long long left, long long right) {
+    BigInteger quotient;
+    BigInteger remainder;
+    BigInteger::divmod(left, right, quotient, remainder);
+    ASSERT_EQ(left / right, quotient);
+    ASSERT_EQ(left % right, remainder);
+}
+
+TEST(BiMethodsTests, DivMod) {
+    test_divmod(179, 57);
+    test_divmod(-179, 57);
+    test_divmod(179, -57);
+    test_divmod(-179, -57);
+    test_divmod(57, 179);
+    test_divmod(179, 179);
+}
+
+TEST(BiMethodsTests, DivModRandom) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger divisor = 0;
+        while (divisor == 0) divisor = random_bigint(1 + i * 5);
+        BigInteger quotient = random_bigint(100);
+        BigInteger remainder = random_bigint(1 + i * 5) % divisor;
+        BigInteger dividend = quotient * divisor + remainder;
+
+        BigInteger result_quotient;
+        BigInteger result_remainder;
+        BigInteger::divmod(dividend, divisor, result_quotient, result_remainder);
+        ASSERT_EQ(quotient, result_quotient);
+        ASSERT_EQ(remainder, result_remainder);
+    }
+}
+
+TEST(BiMethodsTests, DivModAliasing) {
+    BigInteger a = 1791791791;
+    BigInteger b = 57;
+    BigInteger::divmod(a, b, b, a);
+    ASSERT_EQ(1791791791 / 57, b);
+    ASSERT_EQ(1791791791 % 57, a);
+}
+
+TEST(BiMethodsTests, DivModZeroDivision) {
+    BigInteger quotient;
+    BigInteger remainder;
+    ASSERT_THROW(BigInteger::divmod(179, 0, quotient, remainder), DivisionByZeroException);
+}
+
+#define CHECK_AGREED_WITH_BIGINT(op) \
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) { \
+        BigInteger left = random_bigint(1 + i) * (i % 2 == 0 ? 1 : -1); \
+        long long right = random_value() * (i % 3 == 0 ? -1 : 1) + 1; \
+        ASSERT_EQ(left op BigInteger(right), left op right); \
+        ASSERT_EQ(BigInteger(right) op left, right op left); \
+    }
+
+TEST(BiNativeOperandTests, Plus) {
+    CHECK_AGREED_WITH_BIGINT(+);
+}
+
+TEST(BiNativeOperandTests, Minus) {
+    CHECK_AGREED_WITH_BIGINT(-);
+}
+
+TEST(BiNativeOperandTests, Multiply) {
+    CHECK_AGREED_WITH_BIGINT(*);
+}
+
+TEST(BiNativeOperandTests, Divide) {
+    CHECK_AGREED_WITH_BIGINT(/);
+}
+
+TEST(BiNativeOperandTests, Modulo) {
+    CHECK_AGREED_WITH_BIGINT(%);
+}
+
+TEST(BiNativeOperandTests, SignChanges) {
+    BigInteger a = 5;
+    a -= 7;
+    ASSERT_EQ(-2, a);
+    a += 2;
+    ASSERT_EQ(0, a);
+    ASSERT_FALSE(a.is_negative());
+    a -= 1'000'000'000'000ll;
+    ASSERT_EQ(-1'000'000'000'000ll, a);
+    a *= -1;
+    ASSERT_EQ(1'000'000'000'000ll, a);
+    a /= -3;
+    ASSERT_EQ(-333'333'333'333ll, a);
+    a %= 10;
+    ASSERT_EQ(-3, a);
+    a *= 0;
+    ASSERT_FALSE(a.is_negative());
+}
+
+TEST(BiNativeOperandTests, Limits) {
+    const long long ll_min = std::numeric_limits<long long>::min();
+    const unsigned long long ull_max = std::numeric_limits<unsigned long long>::max();
+    BigInteger value = random_bigint(50);
+    ASSERT_EQ(value + BigInteger(ll_min), value + ll_min);
+    ASSERT_EQ(value - BigInteger(ll_min), value - ll_min);
+    ASSERT_EQ(value * BigInteger(ull_max), value * ull_max);
+    ASSERT_EQ(value / BigInteger(ull_max), value / ull_max);
+    ASSERT_EQ(value % BigInteger(ull_max), value % ull_max);
+    ASSERT_EQ(value * BigInteger(ll_min), value * ll_min);
+    ASSERT_EQ(value / BigInteger(ll_min), value / ll_min);
+    ASSERT_EQ(BigInteger(ull_max) - 1, BigInteger(ull_max - 1));
+    ASSERT_EQ(BigInteger(ll_min), BigInteger(0) + ll_min);
+}
+
+TEST(BiNativeOperandTests, Comparison) {
+    BigInteger a = -179;
+    ASSERT_TRUE(a == -179);
+    ASSERT_TRUE(-179 == a);
+    ASSERT_TRUE(a != 179);
+    ASSERT_TRUE(a < 0);
+    ASSERT_TRUE(0u > a);
+    ASSERT_TRUE(a <= -179ll);
+    ASSERT_TRUE(a > std::numeric_limits<long long>::min());
+    ASSERT_TRUE(random_bigint(30) > std::numeric_limits<unsigned long long>::max());
+    ASSERT_TRUE(-random_bigint(30) < std::numeric_limits<long long>::min());
+    ASSERT_TRUE(BigInteger(0) == 0u);
+}
+
+TEST(BiNativeOperandTests, DivisionByZero) {
+    BigInteger a = 179;
+    ASSERT_THROW(a / 0, DivisionByZeroException);
+    ASSERT_THROW(a % 0u, DivisionByZeroException);
+    ASSERT_THROW(a /= 0ll, DivisionByZeroException);
+}
+
+TEST(BiNativeOperandTests, NoAllocations) {
+    BigInteger a = random_bigint(100);
+    a.shift(1);
+    a.shift(-1);
+    OperatorNewCounter cntr(true);
+    a += 1;
+    a -= 12345;
+    a *= 7;
+    a /= 10;
+    a %= 1'000'000'007;
+    ASSERT_EQ(0, cntr.get_counter());
+}
+
+TEST(BiNativeOperandTests, ModuloDoesNotCopy) {
+    BigInteger a = random_bigint(1000);
+    OperatorNewCounter cntr(true);
+    auto rest = a % 179;
+    ASSERT_LE(cntr.get_counter(), 1);
+}
+
+TEST(BiMethodsTests, RandomBelow) {
+    for (size_t size : {1, 17, 18, 19, 100, 1000}) {
+        BigInteger bound = random_bigint(size);
+        for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+            BigInteger value = BigInteger::random_below(test_random, bound);
+            ASSERT_FALSE(value.is_negative());
+            ASSERT_LT(value, bound);
+        }
+    }
+    ASSERT_EQ(0, BigInteger::random_below(test_random, 1));
+    ASSERT_THROW(BigInteger::random_below(test_random, 0), InvalidArgumentException);
+    ASSERT_THROW(BigInteger::random_below(test_random, -5), InvalidArgumentException);
+}
+
+TEST(BiMethodsTests, RandomBelowUniform) {
+    // the highest digits of the bound are 1000...0, so the range of the highest chunk is barely used
+    BigInteger bound = BigInteger("100000000000000000000000000007");
+    const int buckets_count = 10;
+    const int draws_count = 10000;
+    vector<int> counts(buckets_count, 0);
+    for (int i = 0; i < draws_count; ++i) {
+        BigInteger value = BigInteger::random_below(test_random, bound);
+        ++counts[static_cast<long long>(value * buckets_count / bound)];
+    }
+    for (int count : counts) {
+        ASSERT_NEAR(draws_count / buckets_count, count, 150);
+    }
+}
+
+TEST(BiMethodsTests, RandomBits) {
+    for (size_t bits : {1, 63, 64, 65, 1000}) {
+        int highest_set = 0;
+        for (int i = 0; i < 100; ++i) {
+            BigInteger value = BigInteger::random_bits(test_random, bits);
+            ASSERT_LE(value.bit_length(), bits);
+            highest_set += value.bit_length() == bits;
+        }
+        ASSERT_NEAR(50, highest_set, 20) << bits;
+    }
+    ASSERT_EQ(0, BigInteger::random_bits(test_random, 0));
+}
+
+TEST(BiMethodsTests, RandomBatch) {
+    std::mt19937_64 first(57);
+    std::mt19937_64 second(57);
+    BigInteger bound = random_bigint(50);
+    vector<BigInteger> values(100);
+    BigInteger::random_below(first, bound, values);
+    for (const auto& value : values) {
+        ASSERT_LT(value, bound);
+        // the same generator state gives the same values
+        ASSERT_EQ(value, BigInteger::random_below(second, bound));
+    }
+    ASSERT_NE(values[0], values[1]);
+
+    BigInteger::random_bits(first, 100, values);
+    for (const auto& value : values) {
+        ASSERT_LE(value.bit_length(), 100);
+    }
+
+    // the bound is one of the values
+    values[0] = bound;
+    BigInteger::random_below(first, values[0], values);
+    for (const auto& value : values) {
+        ASSERT_LT(value, bound);
+    }
+    ASSERT_NE(values[0], values[1]);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <bit>
+
+#include "bigint_test_helper.h"
+
+// random 63-bit values of both signs
+long long random_signed_word() {
+    long long value = (static_cast<long long>(test_random()) << 31) ^ test_random();
+    return test_random() % 2 ? value : -value;
+}
+
+TEST(BiBitwiseTests, AgreedWithLongLong) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        long long left = random_signed_word();
+        long long right = random_signed_word();
+        ASSERT_EQ(left & right, BigInteger(left) & BigInteger(right));
+        ASSERT_EQ(left | right, BigInteger(left) | BigInteger(right));
+        ASSERT_EQ(left ^ right, BigInteger(left) ^ BigInteger(right));
+        ASSERT_EQ(~left, ~BigInteger(left));
+    }
+}
+
+TEST(BiBitwiseTests, CompoundAssignment) {
+    BigInteger a = 12;
+    a &= 10;
+    ASSERT_EQ(8, a);
+    a |= 3;
+    ASSERT_EQ(11, a);
+    a ^= -1;
+    ASSERT_EQ(-12, a);
+    a &= a;
+    ASSERT_EQ(-12, a);
+}
+
+TEST(BiBitwiseTests, Identities) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger a = random_bigint(60 + i);
+        BigInteger b = random_bigint(80 - i);
+        if (i % 2) a.invert_sign();
+        if (i % 3 == 0) b.invert_sign();
+        ASSERT_EQ(a + b, (a & b) + (a | b));
+        ASSERT_EQ(a ^ b, (a | b) - (a & b));
+        ASSERT_EQ(~(a & b), ~a | ~b);
+        ASSERT_EQ(a, ~~a);
+        ASSERT_EQ(0, a ^ a);
+        ASSERT_EQ(-1, a | ~a);
+    }
+}
+
+TEST(BiBitwiseTests, PowersOfTwo) {
+    BigInteger power = 1;
+    for (size_t i = 0; i < 200; ++i, power *= 2) {
+        ASSERT_EQ(i + 1, power.bit_length());
+        ASSERT_EQ(1, power.popcount());
+        ASSERT_EQ(i, power.countr_zero());
+        ASSERT_EQ(i, (-power).countr_zero());
+        ASSERT_EQ(i, (power - 1).bit_length());
+        ASSERT_EQ(i, (power - 1).popcount());
+        ASSERT_EQ(0, power & (power - 1));
+    }
+}
+
+TEST(BiBitwiseTests, TestBit) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        long long value = random_signed_word();
+        BigInteger big = value;
+        for (size_t bit = 0; bit < 64; ++bit) {
+            ASSERT_EQ((value >> bit) & 1, big.test_bit(bit)) << value << " " << bit;
+        }
+        // the sign is extended infinitely
+        ASSERT_EQ(value < 0, big.test_bit(1000));
+    }
+}
+
+TEST(BiBitwiseTests, BitQueries) {
+    ASSERT_EQ(0, BigInteger(0).bit_length());
+    ASSERT_EQ(0, BigInteger(0).popcount());
+    ASSERT_FALSE(BigInteger(0).test_bit(0));
+    ASSERT_THROW(BigInteger(0).countr_zero(), InvalidArgumentException);
+    ASSERT_EQ(64, BigInteger(std::numeric_limits<unsigned long long>::max()).popcount());
+    ASSERT_EQ(64, BigInteger(std::numeric_limits<long long>::min()).bit_length());
+    ASSERT_EQ(63, BigInteger(std::numeric_limits<long long>::min()).countr_zero());
+    ASSERT_EQ(3, BigInteger(-7).popcount());
+}
+
+TEST(BiBitwiseTests, WordsRoundTrip) {
+    for (size_t size : {1, 19, 20, 39, 100, 1000}) {
+        BigInteger value = random_bigint(size);
+        auto words = value.magnitude_words();
+        ASSERT_TRUE(words.empty() || words.back() != 0);
+        ASSERT_EQ(value, BigInteger::from_magnitude_words(words));
+        ASSERT_EQ(-value, BigInteger::from_magnitude_words(words, true));
+    }
+    ASSERT_TRUE(BigInteger(0).magnitude_words().empty());
+    ASSERT_EQ(0, BigInteger::from_magnitude_words({}, true));
+    ASSERT_FALSE(BigInteger::from_magnitude_words({}, true).is_negative());
+}
+
+TEST(BiBitwiseTests, Words) {
+    BigInteger value = BigInteger("340282366920938463463374607431768211455");
+    vector<unsigned long long> expected(2, std::numeric_limits<unsigned long long>::max());
+    ASSERT_EQ(expected, value.magnitude_words());
+    ASSERT_EQ(expected, (-value).magnitude_words());
+    ASSERT_EQ(128, value.bit_length());
+    ASSERT_EQ(value + 1, BigInteger::from_magnitude_words(vector<unsigned long long>{0, 0, 1}));
+}
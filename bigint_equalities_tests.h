@@ -1,5 +1,7 @@
 #pragma once
 
+#include <unordered_set>
+
 #include "bigint_test_helper.h"
 
 TEST(BiOperatorTests, EqTrue) {
@@ -152,3 +154,28 @@ TEST(BiOperatorTests, Geq) {
     CHECK_AGREED_WITH_INT(>=);
 }
 
+
+TEST(BiOperatorTests, Hash) {
+    std::hash<BigInteger> hasher;
+    for (size_t size : {1, 7, 8, 31, 32, 33, 1000}) {
+        BigInteger a = random_bigint(size);
+        BigInteger b = BigInteger(a.toString());
+        ASSERT_EQ(hasher(a), hasher(b));
+        ASSERT_NE(hasher(a), hasher(-a));
+        ASSERT_NE(hasher(a), hasher(a + 1));
+        ASSERT_NE(hasher(a), hasher(a * 10));
+    }
+    // equal values are built differently, and zero is never negative
+    ASSERT_EQ(hasher(BigInteger(0)), hasher(-BigInteger(0)));
+    ASSERT_EQ(hasher(BigInteger(100)), hasher(BigInteger(1000) / 10));
+}
+
+TEST(BiOperatorTests, HashUnorderedSet) {
+    std::unordered_set<BigInteger> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.insert(BigInteger(i) * 1'000'000'007);
+    }
+    ASSERT_EQ(1000, values.size());
+    ASSERT_TRUE(values.contains(BigInteger(999) * 1'000'000'007));
+    ASSERT_FALSE(values.contains(BigInteger(1000) * 1'000'000'007));
+}
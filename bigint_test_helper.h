@@ -10,12 +10,11 @@ long long random_value() {
     return (test_random() % static_cast<long long>(1e9 + 7));
 }
 
+// exactly size digits, the leading one is nonzero
 BigInteger random_bigint(size_t size) {
-    string value = "";
-    for (size_t i = 0; i < size; ++i) {
-        value += '0' + (abs(random_value()) % 10);
-    }
-    return BigInteger(value);
+    BigInteger lowest = 1;
+    lowest.shift(size - 1);
+    return lowest + BigInteger::random_below(test_random, lowest * 9);
 }
 
 #define CHECK_OPERATOR_ALLOCATIONS(op, max_allocations_count) \
@@ -1,5 +1,8 @@
 #pragma once 
 
+#include <charconv>
+#include <iomanip>
+
 #include "bigint_test_helper.h"
 
 TEST(BiConstructorTests, LLTime) {
@@ -51,6 +54,19 @@ TEST(BiConstructorTests, CopyNegative) {
     ASSERT_EQ(a, b);
 }
 
+TEST(BiConstructorTests, MovedFrom) {
+    BigInteger a("-1234567890123456789");
+    BigInteger b = std::move(a);
+
+    ASSERT_EQ(BigInteger("-1234567890123456789"), b);
+    ASSERT_EQ("0", a.toString());
+    ASSERT_TRUE(a.is_zero());
+    ASSERT_EQ(1, a.size());
+    ASSERT_EQ(BigInteger(0).hash(), a.hash());
+    a += 5;
+    ASSERT_EQ(5, a);
+}
+
 TEST(BiConstructorTests, StringPositive) {
     int num = 1791791791;
     BigInteger a(std::to_string(num));
@@ -131,6 +147,118 @@ TEST(BiMethodTests, ToStringNeg) {
     ASSERT_EQ("-179", a.toString());
 }
 
+TEST(BiMethodTests, ToChars) {
+    for (size_t size : {1, 2, 100}) {
+        BigInteger a = random_bigint(size);
+        if (size % 2 == 0) a.invert_sign();
+        string expected = a.toString();
+        ASSERT_EQ(expected.size(), formatted_size(a));
+        char buffer[128];
+        auto [end, error] = to_chars(buffer, buffer + sizeof(buffer), a);
+        ASSERT_EQ(std::errc(), error);
+        ASSERT_EQ(expected, string(buffer, end));
+    }
+}
+
+TEST(BiMethodTests, ToCharsTooSmall) {
+    BigInteger a = -1791791791;
+    char buffer[11];
+    auto [end, error] = to_chars(buffer, buffer + 10, a);
+    ASSERT_EQ(std::errc::value_too_large, error);
+    ASSERT_EQ(buffer + 10, end);
+    ASSERT_EQ(buffer + 11, to_chars(buffer, buffer + 11, a).ptr);
+}
+
+TEST(BiMethodTests, FromChars) {
+    string source = "-0001791791791791791791791791rest";
+    BigInteger a = 57;
+    auto [end, error] = from_chars(source.data(), source.data() + source.size(), a);
+    ASSERT_EQ(std::errc(), error);
+    ASSERT_EQ("rest", string(end));
+    ASSERT_EQ(BigInteger("-1791791791791791791791791"), a);
+
+    source = "-000";
+    from_chars(source.data(), source.data() + source.size(), a);
+    ASSERT_EQ(0, a);
+    ASSERT_FALSE(a.is_negative());
+}
+
+TEST(BiMethodTests, FromCharsInvalid) {
+    BigInteger a = 57;
+    for (string source : {"", "-", "+1", " 1", "-x1"}) {
+        auto [end, error] = from_chars(source.data(), source.data() + source.size(), a);
+        ASSERT_EQ(std::errc::invalid_argument, error);
+        ASSERT_EQ(source.data(), end);
+        ASSERT_EQ(57, a);
+    }
+}
+
+TEST(BiMethodTests, RadixRoundTrip) {
+    for (size_t size : {1, 30, 1000, 10000}) {
+        BigInteger value = random_bigint(size);
+        if (size % 20 == 0) value.invert_sign();
+        for (int base : {2, 3, 7, 8, 10, 16, 32, 36}) {
+            string digits = value.toString(base);
+            ASSERT_EQ(value, BigInteger(digits, base)) << base;
+            ASSERT_EQ(digits.size(), formatted_size(value, base)) << base;
+        }
+    }
+}
+
+TEST(BiMethodTests, RadixLong) {
+    // long enough for the chunks to be joined by halves
+    BigInteger value = random_bigint(25000);
+    for (int base : {3, 16}) {
+        ASSERT_EQ(value, BigInteger(value.toString(base), base));
+    }
+}
+
+TEST(BiMethodTests, RadixAgreedWithBuiltIn) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        unsigned long long value = (static_cast<unsigned long long>(test_random()) << 32) ^ test_random();
+        for (int base = 2; base <= 36; ++base) {
+            char expected[64];
+            auto end = std::to_chars(expected, expected + sizeof(expected), value, base).ptr;
+            ASSERT_EQ(string(expected, end), BigInteger(value).toString(base));
+        }
+    }
+}
+
+TEST(BiMethodTests, Radix) {
+    ASSERT_EQ("ff", BigInteger(255).toString(16));
+    ASSERT_EQ("-11111111", BigInteger(-255).toString(2));
+    ASSERT_EQ("0", BigInteger(0).toString(7));
+    ASSERT_EQ(BigInteger(std::numeric_limits<uint128_t>::max()), BigInteger(string(32, 'F'), 16));
+    ASSERT_EQ(-1295, BigInteger("-zZ", 36));
+    ASSERT_EQ("1" + string(100, '0'), BigInteger::power(2, 100).toString(2));
+    ASSERT_EQ(BigInteger::power(36, 50), BigInteger("1" + string(50, '0'), 36));
+}
+
+TEST(BiMethodTests, RadixInvalid) {
+    ASSERT_THROW(BigInteger(10).toString(1), InvalidArgumentException);
+    ASSERT_THROW(BigInteger("10", 37), InvalidArgumentException);
+    ASSERT_THROW(BigInteger("12g", 16), InvalidInputException);
+    ASSERT_THROW(BigInteger("", 16), InvalidInputException);
+    ASSERT_THROW(BigInteger("-", 2), InvalidInputException);
+    ASSERT_THROW(BigInteger("102", 2), InvalidInputException);
+
+    string source = "-7fz";
+    BigInteger value;
+    auto [end, error] = from_chars(source.data(), source.data() + source.size(), value, 16);
+    ASSERT_EQ(std::errc(), error);
+    ASSERT_EQ("z", string(end));
+    ASSERT_EQ(-127, value);
+}
+
+TEST(BiMethodTests, ToCharsRadix) {
+    BigInteger value = BigInteger("-123456789abcdef0123456789", 16);
+    char buffer[26];
+    ASSERT_EQ(std::errc::value_too_large, to_chars(buffer, buffer + 25, value, 16).ec);
+    auto [end, error] = to_chars(buffer, buffer + 26, value, 16);
+    ASSERT_EQ(std::errc(), error);
+    ASSERT_EQ("-123456789abcdef0123456789", string(buffer, end));
+}
+
 TEST(BiMethodTests, ToStringZeroesFromString) {
     BigInteger a("000000000179");
 
@@ -151,6 +279,68 @@ TEST(BiOperatorTests, LLCastNeg) {
     ASSERT_EQ(a, b);
 }
 
+TEST(BiOperatorTests, LLCastLimits) {
+    long long max = std::numeric_limits<long long>::max();
+    long long min = std::numeric_limits<long long>::min();
+    ASSERT_EQ(max, static_cast<long long>(BigInteger(max)));
+    ASSERT_EQ(min, static_cast<long long>(BigInteger(min)));
+    ASSERT_EQ(0, static_cast<long long>(BigInteger(0)));
+    ASSERT_THROW(static_cast<long long>(BigInteger(max) + 1), TooBigCastException);
+    ASSERT_THROW(static_cast<long long>(BigInteger(min) - 1), TooBigCastException);
+    ASSERT_THROW(static_cast<long long>(BigInteger(std::numeric_limits<unsigned long long>::max())), TooBigCastException);
+    ASSERT_THROW(static_cast<long long>(BigInteger("9999999999999999999")), TooBigCastException);
+}
+
+// min - 1, min, max and max + 1 of T are checked, as well as random values in range
+template<typename T>
+void check_conversion(const BigInteger& min, const BigInteger& max) {
+    ASSERT_EQ(min, BigInteger(min.to<T>()));
+    ASSERT_EQ(max, BigInteger(max.to<T>()));
+    ASSERT_FALSE((max + 1).try_to<T>().has_value());
+    ASSERT_FALSE((min - 1).try_to<T>().has_value());
+    ASSERT_FALSE((max * 1000).try_to<T>().has_value());
+    ASSERT_THROW((max + 1).to<T>(), TooBigCastException);
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger value = random_bigint(1 + test_random() % max.size());
+        if (value > max) value %= max;
+        if (test_random() % 2 && min.is_negative()) value.invert_sign();
+        auto converted = value.try_to<T>();
+        ASSERT_TRUE(converted.has_value());
+        ASSERT_EQ(value, BigInteger(*converted));
+    }
+}
+
+template<typename T>
+void check_native_conversion() {
+    check_conversion<T>(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+}
+
+TEST(BiOperatorTests, ConversionTo) {
+    check_native_conversion<signed char>();
+    check_native_conversion<unsigned char>();
+    check_native_conversion<short>();
+    check_native_conversion<unsigned short>();
+    check_native_conversion<int>();
+    check_native_conversion<unsigned>();
+    check_native_conversion<long>();
+    check_native_conversion<unsigned long>();
+    check_native_conversion<long long>();
+    check_native_conversion<unsigned long long>();
+    BigInteger two_127 = BigInteger::power(2, 127);
+    check_conversion<int128_t>(-two_127, two_127 - 1);
+    check_conversion<uint128_t>(0, two_127 * 2 - 1);
+}
+
+TEST(BiOperatorTests, ConversionToUnsigned) {
+    ASSERT_THROW(BigInteger(-1).to<unsigned>(), NegativeToUnsignedCastException);
+    ASSERT_THROW(BigInteger(-1).to<uint128_t>(), NegativeToUnsignedCastException);
+    ASSERT_FALSE(BigInteger(-1).try_to<unsigned long long>().has_value());
+    ASSERT_EQ(0u, BigInteger(0).to<unsigned>());
+    ASSERT_THROW(BigInteger("-1000000000000000000000000000000000000000000").to<int128_t>(), TooBigCastException);
+    ASSERT_EQ(std::nullopt, BigInteger("399999999999999999999999999999999999999").try_to<uint128_t>());
+    ASSERT_EQ(-7, BigInteger(-7).to<signed char>());
+}
+
 TEST(BiOperatorTests, LLCastMemory) {
     BigInteger a = 11;
     OperatorNewCounter cntr;
@@ -211,6 +401,49 @@ TEST(BiOperatorTests, Output) {
     ASSERT_EQ(a, result);
 }
 
+TEST(BiOperatorTests, OutputLong) {
+    for (size_t size : {255, 256, 257, 1000}) {
+        BigInteger a = -random_bigint(size);
+        std::stringstream ss;
+        ss << a << ' ' << std::setw(size + 5) << std::setfill('*') << a;
+        ASSERT_EQ(a.toString() + " ****" + a.toString(), ss.str());
+    }
+}
+
+TEST(BiOperatorTests, OutputFlags) {
+    using flags = std::ios_base::fmtflags;
+    std::vector<flags> formats = {std::ios_base::dec, std::ios_base::hex, std::ios_base::oct,
+            std::ios_base::hex | std::ios_base::showbase | std::ios_base::uppercase,
+            std::ios_base::oct | std::ios_base::showbase, std::ios_base::dec | std::ios_base::showpos,
+            std::ios_base::hex | std::ios_base::showpos | std::ios_base::left,
+            std::ios_base::dec | std::ios_base::showpos | std::ios_base::internal,
+            std::ios_base::hex | std::ios_base::showbase | std::ios_base::internal};
+    for (long long value : {0LL, 1LL, 255LL, 1791791791LL, -42LL, -1791791791LL, 0x7fffffffffffffffLL}) {
+        for (flags format : formats) {
+            for (int width : {0, 3, 25}) {
+                std::stringstream expected, actual;
+                expected.flags(format);
+                actual.flags(format);
+                // built-in integers print negative values in hex and octal as unsigned
+                long long printed = value;
+                if (value < 0 && !(format & std::ios_base::dec)) {
+                    expected << '-';
+                    actual << '-';
+                    printed = -value;
+                }
+                expected << std::setw(width) << std::setfill('*') << printed;
+                actual << std::setw(width) << std::setfill('*') << BigInteger(printed);
+                ASSERT_EQ(expected.str(), actual.str());
+            }
+        }
+    }
+
+    std::stringstream ss;
+    BigInteger a("-1208925819614629174706176");
+    ss << std::hex << std::showbase << std::uppercase << a << ' ' << std::setw(30) << std::left << a << '|';
+    ASSERT_EQ("-0X100000000000000000000 -0X100000000000000000000      |", ss.str());
+}
+
 TEST(BiOperatorTests, OutputNegative) {
     std::stringstream ss;
     BigInteger a = -1791791791;
@@ -250,3 +483,64 @@ TEST(BiOperatorTests, LiteralZero) {
     ASSERT_EQ(0, a);
 }
 
+
+TEST(BiConstructorTests, LLMin) {
+    BigInteger a = std::numeric_limits<long long>::min();
+    ASSERT_EQ("-9223372036854775808", a.toString());
+}
+
+TEST(BiConstructorTests, ULLMax) {
+    BigInteger a = std::numeric_limits<unsigned long long>::max();
+    ASSERT_EQ("18446744073709551615", a.toString());
+}
+
+TEST(BiConstructorTests, Unsigned) {
+    BigInteger a = 4000000000u;
+    BigInteger b = 4000000000ul;
+    ASSERT_EQ("4000000000", a.toString());
+    ASSERT_EQ(a, b);
+}
+
+TEST(BiConstructorTests, Int128) {
+    int128_t value = static_cast<int128_t>(std::numeric_limits<long long>::max()) * 1000 + 7;
+    BigInteger a = value;
+    BigInteger b = -value;
+    ASSERT_EQ("9223372036854775807007", a.toString());
+    ASSERT_EQ("-9223372036854775807007", b.toString());
+}
+
+TEST(BiConstructorTests, Int128Limits) {
+    BigInteger max = std::numeric_limits<uint128_t>::max();
+    BigInteger min = std::numeric_limits<int128_t>::min();
+    ASSERT_EQ("340282366920938463463374607431768211455", max.toString());
+    ASSERT_EQ("-170141183460469231731687303715884105728", min.toString());
+}
+
+TEST(BiConstructorTests, Int128Small) {
+    BigInteger a = static_cast<uint128_t>(0);
+    BigInteger b = static_cast<int128_t>(-179);
+    ASSERT_EQ(0, a);
+    ASSERT_EQ(-179, b);
+}
+
+TEST(BiOperatorTests, LiteralBig) {
+    auto a = 18446744073709551615_bi;
+    ASSERT_EQ("18446744073709551615", a.toString());
+}
+
+TEST(BiOperatorTests, LiteralLong) {
+    auto a = 1'000'000'000'000'000'000'000'000'000'000'000'057_bi;
+    ASSERT_EQ(BigInteger("1000000000000000000000000000000000057"), a);
+    ASSERT_EQ(37, a.size());
+    ASSERT_EQ(BigInteger("-1000000000000000000000000000000000057"), -1000000000000000000000000000000000057_bi);
+}
+
+TEST(BiOperatorTests, LiteralRadixes) {
+    ASSERT_EQ(BigInteger(std::numeric_limits<uint128_t>::max()), 0xFFFF'FFFF'FFFF'FFFF'ffff'ffff'ffff'ffff_bi);
+    ASSERT_EQ(BigInteger::power(2, 100), 0x10000000000000000000000000_bi);
+    ASSERT_EQ(10, 0b1010_bi);
+    ASSERT_EQ(511, 0777_bi);
+    ASSERT_EQ(0, 0x0_bi);
+    ASSERT_EQ(0, 0_bi);
+    ASSERT_EQ(7, 0007_bi);
+}
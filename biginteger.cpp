@@ -1,12 +1,53 @@
+#include <algorithm>
 #include <assert.h>
+#include <bit>
+#include <cctype>
+#include <cstring>
+#include <functional>
+#include <future>
 #include <limits>
+#include <memory>
 #include "biginteger.h"
 #include "exceptions.h"
+#include "stats.h"
 #include <math.h>
 
 
-BigInteger longMin = BigInteger(std::numeric_limits<long long>::min());
-BigInteger longMax = BigInteger(std::numeric_limits<long long>::max()); 
+// inverses of digits coprime with BASE, REWRITE IF BASE CHANGES!!!!
+constexpr digit_t DIGIT_INVERSE[] = {0, 1, 0, 7, 0, 0, 0, 3, 0, 9};
+
+// any number of this many digits fits into unsigned long long
+constexpr size_t WORD_DIGITS = std::numeric_limits<unsigned long long>::digits10;
+
+// the same for 128-bit words, WIDE_POWER = BASE^WIDE_DIGITS
+constexpr size_t WIDE_DIGITS = 38;
+constexpr uint128_t WIDE_POWER = [] {
+    uint128_t power = 1;
+    for (size_t i = 0; i < WIDE_DIGITS; ++i) power *= 10;
+    return power;
+}();
+
+// exact division uses the inverse modulo a power of BASE instead of digit by digit elimination
+// when both the quotient and the divisor are longer than that
+constexpr size_t HENSEL_INVERSE_LIMIT = 15000;
+
+// accumulated products take multipliers of this many digits, so that a digit times multiplier plus carry fits into a word
+constexpr size_t SCALED_MULTIPLIER_DIGITS = 18;
+constexpr unsigned long long SCALED_MULTIPLIER_BASE = 1'000'000'000'000'000'000ull;
+
+// addmul and submul add products digit by digit while the product of the lengths is at most this many times
+// n log n of the transform size n, the digit by digit way takes about as long as the transform there
+constexpr size_t ADDMUL_SCHOOLBOOK_RATIO = 200;
+
+// multiplier of the digits hash, an odd number with well mixed bits (2^64 divided by the golden ratio)
+constexpr unsigned long long HASH_MULTIPLIER = 0x9e3779b97f4a7c15ull;
+
+// characters of digits in bases up to 36
+constexpr char RADIX_DIGITS[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+// parsed chunks of digits in other bases are combined by Horner's scheme when there are at most this many of them,
+// longer sequences are split in halves which are joined by a multiplication
+constexpr size_t RADIX_HORNER_LIMIT = 1024;
 
 size_t revert_binary(size_t index, size_t length) {
     size_t result = 0;
@@ -18,6 +59,38 @@ size_t revert_binary(size_t index, size_t length) {
     return result;
 }
 
+static unsigned long long mix_hash(unsigned long long state, unsigned long long word) {
+    state = (state ^ word) * HASH_MULTIPLIER;
+    return state ^ (state >> 29);
+}
+
+size_t BigInteger::hash() const {
+    const size_t word_size = sizeof(unsigned long long);
+    const size_t lanes_count = 4;
+    unsigned long long lanes[lanes_count] = {size(), negative, 0, 0};
+    const digit_t* data = digits.data();
+    size_t position = 0;
+    for (; position + lanes_count * word_size <= size(); position += lanes_count * word_size) {
+        for (size_t lane = 0; lane < lanes_count; ++lane) {
+            unsigned long long word;
+            std::memcpy(&word, data + position + lane * word_size, word_size);
+            lanes[lane] = mix_hash(lanes[lane], word);
+        }
+    }
+    // the rest is padded by zeroes, the size is hashed already
+    for (size_t lane = 0; position < size(); ++lane, position += word_size) {
+        unsigned long long word = 0;
+        std::memcpy(&word, data + position, std::min(word_size, size() - position));
+        lanes[lane] = mix_hash(lanes[lane], word);
+    }
+
+    unsigned long long result = 0;
+    for (auto lane : lanes) {
+        result = mix_hash(result, lane);
+    }
+    return static_cast<size_t>(result);
+}
+
 size_t BigInteger::size() const {
     return digits.size();
 }
@@ -128,27 +201,237 @@ void BigInteger::substract_absolute(const BigInteger& other) {
 
 BigInteger::BigInteger() : BigInteger(0) {}
 
-BigInteger::BigInteger(long long value) {
-    bool special_case = false;
-    if (value < 0) {
-        negative = true;
-        if (value == std::numeric_limits<long long>::min()) {
-            special_case = true;
-            ++value;
-        }
-        value = -value;
-    }
+void BigInteger::assign_magnitude(unsigned long long value) {
+    // fill a local buffer first to allocate the vector only once
+    digit_t buffer[std::numeric_limits<unsigned long long>::digits10 + 1];
+    size_t length = 0;
     do {
-        digits.push_back(value % BASE);
+        buffer[length++] = value % BASE;
         value /= BASE;
     } while(value > 0);
-    if (special_case) --*this;
+    digits.assign(buffer, buffer + length);
+}
+
+void BigInteger::assign_magnitude(uint128_t value) {
+    // 128-bit division is slow, so split off chunks of 19 digits and do the rest in 64 bits
+    const unsigned long long chunk_base = 10'000'000'000'000'000'000ull;
+    const size_t chunk_length = std::numeric_limits<unsigned long long>::digits10;
+
+    digit_t buffer[std::numeric_limits<uint128_t>::digits10 + 1];
+    size_t length = 0;
+    while (value > std::numeric_limits<unsigned long long>::max()) {
+        unsigned long long chunk = value % chunk_base;
+        value /= chunk_base;
+        for (size_t i = 0; i < chunk_length; ++i) {
+            buffer[length++] = chunk % BASE;
+            chunk /= BASE;
+        }
+    }
+    assign_magnitude(static_cast<unsigned long long>(value));
+    digits.insert(digits.begin(), buffer, buffer + length);
+}
+
+void BigInteger::add_word(unsigned long long magnitude, bool operand_negative) {
+    if (magnitude == 0) return;
+    if (is_zero()) negative = operand_negative;
+
+    if (negative == operand_negative) {
+        unsigned long long carry = magnitude;
+        for (size_t index = 0; carry > 0; ++index) {
+            if (index == size()) digits.push_back(0);
+            unsigned long long current = digits[index] + carry % BASE;
+            digits[index] = current % BASE;
+            carry = carry / BASE + current / BASE;
+        }
+        return;
+    }
+
+    if (compare_magnitude_word(magnitude) == strong_ordering::less) {
+        // this is shorter than magnitude, so it fits into a word
+        unsigned long long value = 0;
+        for (size_t i = size(); i > 0; --i) {
+            value = value * BASE + digits[i - 1];
+        }
+        assign_magnitude(magnitude - value);
+        negative = operand_negative;
+        return;
+    }
+
+    unsigned long long borrow = magnitude;
+    for (size_t index = 0; borrow > 0; ++index) {
+        digit_t substracted = borrow % BASE;
+        borrow /= BASE;
+        if (digits[index] < substracted) {
+            digits[index] += BASE - substracted;
+            ++borrow;
+        } else {
+            digits[index] -= substracted;
+        }
+    }
+    clear_leading_zeroes(digits);
+    resolve_sign();
+}
+
+void BigInteger::multiply_word(unsigned long long magnitude, bool operand_negative) {
+    if (magnitude == 0 || is_zero()) {
+        digits.assign(1, 0);
+        negative = false;
+        return;
+    }
+    negative ^= operand_negative;
+
+    // a digit times magnitude plus the carry fits into a word unless magnitude is too big
+    if (magnitude <= std::numeric_limits<unsigned long long>::max() / BASE) {
+        unsigned long long carry = 0;
+        for (auto& digit : digits) {
+            unsigned long long current = digit * magnitude + carry;
+            digit = current % BASE;
+            carry = current / BASE;
+        }
+        for (; carry > 0; carry /= BASE) {
+            digits.push_back(carry % BASE);
+        }
+    } else {
+        uint128_t carry = 0;
+        for (auto& digit : digits) {
+            uint128_t current = digit * static_cast<uint128_t>(magnitude) + carry;
+            digit = current % BASE;
+            carry = current / BASE;
+        }
+        for (; carry > 0; carry /= BASE) {
+            digits.push_back(carry % BASE);
+        }
+    }
+}
+
+unsigned long long BigInteger::divide_word(unsigned long long magnitude, bool operand_negative) {
+    if (magnitude == 0) throw DivisionByZeroException(*this);
+
+    // the remainder times BASE plus a digit fits into a word unless magnitude is too big
+    unsigned long long remainder = 0;
+    if (magnitude <= std::numeric_limits<unsigned long long>::max() / BASE) {
+        for (size_t i = size(); i > 0; --i) {
+            unsigned long long current = remainder * BASE + digits[i - 1];
+            digits[i - 1] = current / magnitude;
+            remainder = current % magnitude;
+        }
+    } else {
+        for (size_t i = size(); i > 0; --i) {
+            uint128_t current = static_cast<uint128_t>(remainder) * BASE + digits[i - 1];
+            digits[i - 1] = current / magnitude;
+            remainder = current % magnitude;
+        }
+    }
+    clear_leading_zeroes(digits);
+    negative ^= operand_negative;
+    resolve_sign();
+    return remainder;
+}
+
+unsigned long long BigInteger::remainder_word(unsigned long long magnitude) const {
+    if (magnitude == 0) throw DivisionByZeroException(*this);
+
+    unsigned long long remainder = 0;
+    if (magnitude <= std::numeric_limits<unsigned long long>::max() / BASE) {
+        for (size_t i = size(); i > 0; --i) {
+            remainder = (remainder * BASE + digits[i - 1]) % magnitude;
+        }
+    } else {
+        for (size_t i = size(); i > 0; --i) {
+            remainder = (static_cast<uint128_t>(remainder) * BASE + digits[i - 1]) % magnitude;
+        }
+    }
+    return remainder;
+}
+
+strong_ordering BigInteger::compare_magnitude_word(unsigned long long magnitude) const {
+    if (size() > std::numeric_limits<unsigned long long>::digits10 + 1) return strong_ordering::greater;
+    uint128_t value = 0;
+    for (size_t i = size(); i > 0; --i) {
+        value = value * BASE + digits[i - 1];
+    }
+    return value <=> static_cast<uint128_t>(magnitude);
+}
+
+unsigned long long BigInteger::magnitude_word() const {
+    unsigned long long value = 0;
+    for (size_t i = size(); i > 0; --i) {
+        value = value * BASE + digits[i - 1];
+    }
+    return value;
+}
+
+std::optional<uint128_t> BigInteger::wide_magnitude() const {
+    // WIDE_DIGITS digits always fit, and one more digit overflows unless the rest is small enough
+    if (size() > WIDE_DIGITS + 1) return std::nullopt;
+    size_t highest = size() > WIDE_DIGITS ? 1 : 0;
+    uint128_t value = 0;
+    for (size_t i = size() - highest; i > 0; --i) {
+        value = value * BASE + digits[i - 1];
+    }
+    if (highest == 0) return value;
+
+    // leading * BASE^WIDE_DIGITS + value must not exceed the maximum
+    const uint128_t max = ~static_cast<uint128_t>(0);
+    uint128_t leading = digits.back();
+    if (leading > max / WIDE_POWER || leading * WIDE_POWER > max - value) return std::nullopt;
+    return leading * WIDE_POWER + value;
+}
+
+void BigInteger::throw_cast_exception(const std::type_info& cast_type, bool to_unsigned) const {
+    if (to_unsigned && negative) throw NegativeToUnsignedCastException(*this, cast_type);
+    throw TooBigCastException(*this, cast_type);
+}
+
+size_t BigInteger::trailing_zeroes() const {
+    size_t result = 0;
+    while (result + 1 < size() && digits[result] == 0) ++result;
+    return result;
+}
+
+strong_ordering BigInteger::compare_word(unsigned long long magnitude, bool operand_negative) const {
+    if (magnitude == 0) operand_negative = false;
+    if (negative != operand_negative) return negative ? strong_ordering::less : strong_ordering::greater;
+    auto result = compare_magnitude_word(magnitude);
+    return negative ? 0 <=> result : result;
+}
+
+BigInteger::BigInteger(int value) : BigInteger(static_cast<long long>(value)) {}
+
+BigInteger::BigInteger(long value) : BigInteger(static_cast<long long>(value)) {}
+
+BigInteger::BigInteger(long long value) : negative(value < 0) {
+    // unsigned negation works for the minimal value as well
+    assign_magnitude(negative ? 0ull - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value));
+}
+
+BigInteger::BigInteger(unsigned value) : BigInteger(static_cast<unsigned long long>(value)) {}
+
+BigInteger::BigInteger(unsigned long value) : BigInteger(static_cast<unsigned long long>(value)) {}
+
+BigInteger::BigInteger(unsigned long long value) {
+    assign_magnitude(value);
+}
+
+BigInteger::BigInteger(int128_t value) : negative(value < 0) {
+    assign_magnitude(negative ? 0 - static_cast<uint128_t>(value) : static_cast<uint128_t>(value));
+}
+
+BigInteger::BigInteger(uint128_t value) {
+    assign_magnitude(value);
 }
 
 BigInteger::BigInteger(const BigInteger& source) 
         : digits(source.digits.begin(), source.digits.end())
         , negative(source.negative) {}
 
+BigInteger::BigInteger(BigInteger&& source) noexcept
+        : digits(std::move(source.digits))
+        , negative(source.negative) {
+    source.digits.assign(1, 0);
+    source.negative = false;
+}
+
 BigInteger::BigInteger(const string& source) {
     size_t offset = 0;
     if (source[0] == '-') {
@@ -162,6 +445,17 @@ BigInteger::BigInteger(const string& source) {
     clear_leading_zeroes(digits);
 }
 
+BigInteger::BigInteger(const string& source, int base) : BigInteger() {
+    auto [end, error] = from_chars(source.data(), source.data() + source.size(), *this, base);
+    if (error != std::errc() || end != source.data() + source.size()) throw InvalidInputException(source);
+}
+
+BigInteger::BigInteger(vector<digit_t>&& digits, bool negative) : digits(std::move(digits)), negative(negative) {}
+
+BigInteger BigInteger::from_literal_digits(std::span<const digit_t> source) {
+    return BigInteger(vector<digit_t>(source.begin(), source.end()), false);
+}
+
 BigInteger& BigInteger::operator=(const BigInteger& source) {
     digits.resize(source.size());
     negative = source.negative;
@@ -171,6 +465,12 @@ BigInteger& BigInteger::operator=(const BigInteger& source) {
     return *this;
 }
 
+BigInteger& BigInteger::operator=(BigInteger&& source) noexcept {
+    digits.swap(source.digits);
+    std::swap(negative, source.negative);
+    return *this;
+}
+
 BigInteger& BigInteger::operator+=(const BigInteger& other) {
     if (negative == other.negative) {
         add_absolute(other);
@@ -189,26 +489,91 @@ BigInteger& BigInteger::operator-=(const BigInteger& other) {
     return *this;
 }
 
-vector<complex> BigInteger::digits_to_complex(const vector<digit_t>& values, size_t target_size) {
-    assert(target_size > values.size());
+// bit reversal permutation and roots of unity for one transform size,
+// every multiplication of the same size class needs the same tables
+struct FftPlan {
+    vector<size_t> reversed;
+    // roots[k] = exp(2 * pi * i * k / size) for k < size / 2
+    vector<complex> roots;
+};
+
+// plans take about 24 bytes per point, so only the plans of sizes up to 2^FFT_CACHED_PLAN_LENGTH are cached
+// per thread (on the first use of each size). A longer plan lives while it is used, transforms of the same
+// size which overlap with it share it
+constexpr size_t FFT_CACHED_PLAN_LENGTH = 18;
+
+static std::shared_ptr<const FftPlan> build_fft_plan(size_t size, size_t length) {
+    auto plan = std::make_shared<FftPlan>();
+    plan->reversed.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        plan->reversed[i] = revert_binary(i, length);
+    }
+    plan->roots.resize(size / 2);
+    for (size_t i = 0; i < size / 2; ++i) {
+        long double angle = 2 * M_PI * i / size;
+        plan->roots[i] = complex(cosl(angle), sinl(angle));
+    }
+    return plan;
+}
+
+static std::shared_ptr<const FftPlan> fft_plan(size_t size) {
+    size_t length = 0;
+    while ((static_cast<size_t>(1) << length) < size) ++length;
+
+    if (length > FFT_CACHED_PLAN_LENGTH) {
+        thread_local std::weak_ptr<const FftPlan> long_plan;
+        auto plan = long_plan.lock();
+        if (plan == nullptr || plan->reversed.size() != size) {
+            plan = build_fft_plan(size, length);
+            long_plan = plan;
+        }
+        return plan;
+    }
+
+    thread_local vector<std::shared_ptr<const FftPlan>> plans;
+    if (plans.size() <= length) plans.resize(length + 1);
+    if (plans[length] == nullptr) plans[length] = build_fft_plan(size, length);
+    return plans[length];
+}
+
+size_t BigInteger::fft_size(size_t target_size) {
     size_t result_size = 1;
     while(target_size > 0) {
         result_size *= 2;
         target_size /= 2;
     }
-    vector<complex> result(result_size, 0);
-    for (size_t i = 0; i < values.size(); ++i) {
-        result[i] = static_cast<complex>(values[i]);
+    return result_size;
+}
+
+void BigInteger::digits_to_complex(const vector<digit_t>& real_part, const vector<digit_t>& imaginary_part, vector<complex>& result) {
+    result.assign(fft_size(real_part.size() + imaginary_part.size()), 0);
+    for (size_t i = 0; i < real_part.size(); ++i) {
+        result[i].real(real_part[i]);
+    }
+    for (size_t i = 0; i < imaginary_part.size(); ++i) {
+        result[i].imag(imaginary_part[i]);
     }
+}
 
-    return result;
+void BigInteger::packed_product_spectrum(vector<complex>& values) {
+    // with X the transform of a + i * b, the transforms of real a and b are
+    // A[k] = (X[k] + conj(X[-k])) / 2 and B[k] = (X[k] - conj(X[-k])) / 2i,
+    // so A[k] * B[k] = (X[k]^2 - conj(X[-k])^2) / 4i
+    const complex four_i = complex(0, 4);
+    for (size_t k = 0; k <= values.size() / 2; ++k) {
+        size_t mirrored = (values.size() - k) % values.size();
+        complex direct = values[k];
+        complex reflected = std::conj(values[mirrored]);
+        values[k] = (direct * direct - reflected * reflected) / four_i;
+        values[mirrored] = std::conj(reflected * reflected - direct * direct) / four_i;
+    }
 }
 
-vector<digit_t> BigInteger::complex_to_digits(const vector<complex>& values) {
+vector<digit_t> BigInteger::complex_to_digits(const vector<complex>& values, bool imaginary) {
     vector<digit_t> result(values.size(), 0);
     int carry = 0;
     for (size_t i = 0; i < result.size(); ++i) {
-        carry += static_cast<int>(values[i].real() + 0.5);
+        carry += static_cast<int>((imaginary ? values[i].imag() : values[i].real()) + 0.5);
         result[i] = carry % BASE;
         carry /= BASE;
     }
@@ -223,40 +588,37 @@ vector<digit_t> BigInteger::complex_to_digits(const vector<complex>& values) {
 }
 
 void BigInteger::reorder_for_fft(vector<complex>& source) {
-    size_t length = 0;
-    while((1u << length) < source.size()) ++length;
+    auto plan = fft_plan(source.size());
+    const auto& reversed = plan->reversed;
 
     for (size_t i = 0; i < source.size(); ++i) {
-        if (i < revert_binary(i, length)) {
-            std::swap(source[i], source[revert_binary(i, length)]);
+        if (i < reversed[i]) {
+            std::swap(source[i], source[reversed[i]]);
         }
     }
 }
 
 void BigInteger::fft(vector<complex>& source, bool inversed) {
-    complex root_coefficient = complex(-1.0, inversed ? -0.0 : 0.0);
+    auto plan = fft_plan(source.size());
+    const auto& roots = plan->roots;
 
     reorder_for_fft(source);
 
     for (size_t block_length = 2; block_length <= source.size(); block_length *= 2) {
-        long double angle = 2 * M_PI / block_length * (inversed ? -1 : 1);
-        root_coefficient = complex(cosl(angle), sinl(angle));
+        size_t root_step = source.size() / block_length;
 
         for (size_t block_id = 0; block_id < source.size() / block_length; ++block_id) {
             size_t left_part = block_id * block_length;
             size_t right_part = left_part + block_length / 2;
-           
-            complex current_root = 1;
 
             for (size_t i = 0; i < block_length / 2; ++i) {
+                complex current_root = inversed ? std::conj(roots[i * root_step]) : roots[i * root_step];
                 complex first = source[left_part + i] + current_root * source[right_part + i];
                 complex second = source[left_part + i] - current_root * source[right_part + i];
                 source[left_part + i] = first;
                 source[right_part + i] = second;
-                current_root *= root_coefficient;
             } 
         }
-        //root_coefficient = std::sqrt(root_coefficient);
     }
 
     if (inversed) {
@@ -266,67 +628,464 @@ void BigInteger::fft(vector<complex>& source, bool inversed) {
     }
 }
 
-BigInteger& BigInteger::operator*=(const BigInteger& other) {
-    auto my_complex_values = digits_to_complex(digits, size() + other.size());
-    fft(my_complex_values);
-    
-    auto other_complex_values = digits_to_complex(other.digits, size() + other.size());
-    fft(other_complex_values);
+vector<digit_t> BigInteger::multiply_magnitudes(const vector<digit_t>& left, const vector<digit_t>& right) {
+    BIGINT_STATS_SCOPE(BigIntOperation::MultiplyFft, std::max(left.size(), right.size()));
 
-    for (size_t i = 0; i < my_complex_values.size(); ++i) {
-        my_complex_values[i] *= other_complex_values[i];
-    }
+    // both operands go into one transform as its real and imaginary parts
+    vector<complex> values;
+    digits_to_complex(left, right, values);
+    // a plan which is not cached is built once for both transforms
+    auto plan = fft_plan(values.size());
+    fft(values);
+    packed_product_spectrum(values);
+    fft(values, true);
 
-    fft(my_complex_values, true);
-    digits = std::move(complex_to_digits(my_complex_values));
+    BIGINT_STATS_ALLOCATION(BigIntOperation::MultiplyFft, values.size() * (sizeof(complex) + sizeof(digit_t)));
+    return complex_to_digits(values);
+}
+
+BigInteger& BigInteger::operator*=(const BigInteger& other) {
+    digits = multiply_magnitudes(digits, other.digits);
     negative ^= other.negative;
     if (is_zero() || other.is_zero()) negative = false;
 
     return *this;
 }
 
+void BigInteger::multiply_batch(std::span<const BigInteger> left, std::span<const BigInteger> right,
+        std::span<BigInteger> result, size_t threads_count) {
+    if (left.size() != right.size() || left.size() != result.size()) {
+        throw InvalidArgumentException(std::to_string(left.size()) + ", " + std::to_string(right.size()) + " and "
+            + std::to_string(result.size()) + " elements", "spans of the same size");
+    }
+    if (threads_count == 0) throw InvalidArgumentException("0 threads", "at least one thread");
+    if (left.empty()) return;
+
+    // products of the same transform size go next to each other
+    vector<size_t> order(left.size());
+    vector<size_t> sizes(left.size());
+    for (size_t i = 0; i < left.size(); ++i) {
+        order[i] = i;
+        sizes[i] = fft_size(left[i].size() + right[i].size());
+    }
+    std::stable_sort(order.begin(), order.end(), [&sizes](size_t first, size_t second) {
+        return sizes[first] < sizes[second];
+    });
+
+    // every thread takes a contiguous part of order, split at even positions to keep the pairs
+    auto multiply_range = [&](size_t begin, size_t end) {
+        BIGINT_STATS_SCOPE(BigIntOperation::MultiplyBatch, sizes[order[end - 1]]);
+        vector<complex> values;
+        vector<complex> second_values;
+
+        for (size_t position = begin; position < end; ) {
+            size_t first = order[position];
+            bool negative = left[first].negative != right[first].negative;
+            digits_to_complex(left[first].digits, right[first].digits, values);
+            auto plan = fft_plan(values.size());
+            fft(values);
+            packed_product_spectrum(values);
+
+            // two products of the same size share the inverse transform:
+            // the second one goes to the imaginary part as both results are real
+            if (position + 1 < end && sizes[order[position + 1]] == sizes[first]) {
+                size_t second = order[position + 1];
+                bool second_negative = left[second].negative != right[second].negative;
+                digits_to_complex(left[second].digits, right[second].digits, second_values);
+                fft(second_values);
+                packed_product_spectrum(second_values);
+                for (size_t i = 0; i < values.size(); ++i) {
+                    values[i] += complex(0, 1) * second_values[i];
+                }
+                fft(values, true);
+
+                result[second].digits = complex_to_digits(values, true);
+                result[second].negative = second_negative;
+                result[second].resolve_sign();
+                position += 2;
+            } else {
+                fft(values, true);
+                position += 1;
+            }
+
+            result[first].digits = complex_to_digits(values);
+            result[first].negative = negative;
+            result[first].resolve_sign();
+        }
+    };
+
+    size_t part = (order.size() + threads_count - 1) / threads_count;
+    part += part % 2;
+    vector<std::future<void>> parts;
+    for (size_t begin = part; begin < order.size(); begin += part) {
+        parts.push_back(std::async(std::launch::async, multiply_range, begin, std::min(begin + part, order.size())));
+    }
+    multiply_range(0, std::min(part, order.size()));
+    for (auto& future : parts) {
+        future.get();
+    }
+}
+
+bool BigInteger::accumulate_scaled(const vector<digit_t>& value, unsigned long long multiplier, size_t offset, bool substract) {
+    // carry is at most multiplier + 1, so a digit product plus carry fits into a word
+    unsigned long long carry = 0;
+    size_t index = offset;
+    if (substract) {
+        for (size_t i = 0; i < value.size() || (carry != 0 && index < size()); ++i, ++index) {
+            carry += (i < value.size() ? value[i] * multiplier : 0);
+            digit_t substracted = carry % BASE;
+            carry /= BASE;
+            if (digits[index] < substracted) {
+                digits[index] += BASE - substracted;
+                ++carry;
+            } else {
+                digits[index] -= substracted;
+            }
+        }
+    } else {
+        for (size_t i = 0; i < value.size() || (carry != 0 && index < size()); ++i, ++index) {
+            carry += digits[index] + (i < value.size() ? value[i] * multiplier : 0);
+            digits[index] = carry % BASE;
+            carry /= BASE;
+        }
+    }
+    return carry != 0;
+}
+
+void BigInteger::begin_accumulation(size_t product_size) {
+    digits.resize(std::max(size(), product_size) + 1, 0);
+}
+
+void BigInteger::finish_accumulation(bool borrowed) {
+    if (borrowed) {
+        // BASE^size() - magnitude
+        int borrow = 0;
+        for (auto& digit : digits) {
+            int current = -digit - borrow;
+            borrow = current < 0;
+            digit = current + borrow * BASE;
+        }
+        negative = !negative;
+    }
+    clear_leading_zeroes(digits);
+    resolve_sign();
+}
+
+void BigInteger::add_product_word(const BigInteger& value, unsigned long long magnitude, bool product_negative) {
+    if (&value == this) {
+        BigInteger product = value;
+        product.multiply_word(magnitude, product_negative);
+        *this += product;
+        return;
+    }
+    if (magnitude == 0 || value.is_zero()) return;
+    if (is_zero()) negative = false;
+
+    bool substract = negative != (value.negative != product_negative);
+    begin_accumulation(value.size() + SCALED_MULTIPLIER_DIGITS + 2);
+    bool borrowed = accumulate_scaled(value.digits, magnitude % SCALED_MULTIPLIER_BASE, 0, substract);
+    if (magnitude >= SCALED_MULTIPLIER_BASE) {
+        borrowed |= accumulate_scaled(value.digits, magnitude / SCALED_MULTIPLIER_BASE, SCALED_MULTIPLIER_DIGITS, substract);
+    }
+    finish_accumulation(borrowed);
+}
+
+void BigInteger::add_product(const BigInteger& left, const BigInteger& right, bool substract_product) {
+    if (&left == this || &right == this) {
+        BigInteger product = left * right;
+        substract_product ? *this -= product : *this += product;
+        return;
+    }
+    if (left.is_zero() || right.is_zero()) return;
+    if (is_zero()) negative = false;
+
+    bool product_negative = (left.negative != right.negative) != substract_product;
+    bool substract = negative != product_negative;
+    begin_accumulation(left.size() + right.size());
+    bool borrowed = false;
+    const BigInteger& shorter = left.size() < right.size() ? left : right;
+    const BigInteger& longer = left.size() < right.size() ? right : left;
+    size_t transform_size = fft_size(left.size() + right.size());
+    size_t transform_cost = transform_size * (std::bit_width(transform_size) - 1);
+    if (shorter.size() * longer.size() <= ADDMUL_SCHOOLBOOK_RATIO * transform_cost) {
+        // the shorter operand is taken by words
+        for (size_t offset = 0; offset < shorter.size(); offset += SCALED_MULTIPLIER_DIGITS) {
+            unsigned long long multiplier = 0;
+            for (size_t i = std::min(shorter.size(), offset + SCALED_MULTIPLIER_DIGITS); i > offset; --i) {
+                multiplier = multiplier * BASE + shorter.digits[i - 1];
+            }
+            if (multiplier != 0) borrowed |= accumulate_scaled(longer.digits, multiplier, offset, substract);
+        }
+    } else {
+        borrowed = accumulate_scaled(multiply_magnitudes(left.digits, right.digits), 1, 0, substract);
+    }
+    finish_accumulation(borrowed);
+}
+
+void BigInteger::addmul(BigInteger& accumulator, const BigInteger& left, const BigInteger& right) {
+    accumulator.add_product(left, right, false);
+}
+
+void BigInteger::submul(BigInteger& accumulator, const BigInteger& left, const BigInteger& right) {
+    accumulator.add_product(left, right, true);
+}
+
 void BigInteger::shift(int digits) {
-    string characters = toString();
-    for (int i = 0; i < digits; ++i) {
-        characters.push_back('0');
+    if (digits >= 0) {
+        if (!is_zero()) this->digits.insert(this->digits.begin(), digits, 0);
+        return;
     }
-    for (int i = digits; i < 0 && characters.size(); ++i) {
-        characters.pop_back();
+
+    size_t removed = std::min(static_cast<size_t>(-static_cast<long long>(digits)), size());
+    this->digits.erase(this->digits.begin(), this->digits.begin() + removed);
+    if (this->digits.empty()) this->digits.push_back(0);
+    resolve_sign();
+}
+
+void BigInteger::truncate(size_t digits) {
+    if (digits >= size()) return;
+    this->digits.resize(std::max<size_t>(digits, 1));
+    if (digits == 0) this->digits[0] = 0;
+    clear_leading_zeroes(this->digits);
+    resolve_sign();
+}
+
+digit_t BigInteger::digit(size_t index) const {
+    return index < size() ? digits[index] : 0;
+}
+
+bool BigInteger::greater_or_equal_shifted(const vector<digit_t>& value, const vector<digit_t>& other, size_t offset) {
+    if (value.size() != other.size() + offset) return value.size() > other.size() + offset;
+    for (size_t i = other.size(); i > 0; --i) {
+        if (value[i - 1 + offset] != other[i - 1]) return value[i - 1 + offset] > other[i - 1];
     }
-    if (characters.size() == 0) characters.push_back('0');
+    return true;
+}
 
-    *this = BigInteger(characters);
+void BigInteger::substract_multiple_shifted(vector<digit_t>& value, const vector<digit_t>& other, digit_t multiplier, size_t offset) {
+    int carry = 0;
+    for (size_t i = 0; i < other.size() || carry != 0; ++i) {
+        int current = value[i + offset] - carry - (i < other.size() ? other[i] * multiplier : 0);
+        carry = 0;
+        if (current < 0) {
+            carry = (-current + BASE - 1) / BASE;
+            current += carry * BASE;
+        }
+        value[i + offset] = current;
+    }
+    clear_leading_zeroes(value);
 }
 
-BigInteger& BigInteger::operator/=(const BigInteger& other) {
-    if (other.is_zero()) throw DivisionByZeroException(*this);
-    if (other.size() > size()) return *this = 0;
-    
-    bool old_negative = negative;
-    BigInteger result = 0;
-    
-    auto substracted = other;
-    substracted.shift(size() - other.size());
-    substracted.negative = negative;
-    
-    for (size_t offset = size() - other.size(); offset + 1 > 0; --offset) {
-        result.shift(1);
-        while(compare_absolute(substracted) >= 0) {
-            *this -= substracted;
-            ++result;
+digit_t BigInteger::estimate_quotient_digit(const vector<digit_t>& value, const vector<digit_t>& other, size_t offset) {
+    // compare only the leading digits: value / BASE^(offset + skipped) and other / BASE^skipped
+    // fit into 64 bits, and rounding other up makes the estimation not bigger than the real digit
+    const size_t significant_digits = 17;
+    size_t skipped = other.size() > significant_digits ? other.size() - significant_digits : 0;
+
+    unsigned long long value_top = 0;
+    for (size_t i = other.size() + 1; i > skipped; --i) {
+        size_t index = i - 1 + offset;
+        value_top = value_top * BASE + (index < value.size() ? value[index] : 0);
+    }
+    unsigned long long other_top = 0;
+    for (size_t i = other.size(); i > skipped; --i) {
+        other_top = other_top * BASE + other[i - 1];
+    }
+    if (skipped > 0) ++other_top;
+
+    return std::min<unsigned long long>(value_top / other_top, BASE - 1);
+}
+
+void BigInteger::divmod(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder) {
+    if (divisor.is_zero()) throw DivisionByZeroException(dividend);
+    BIGINT_STATS_SCOPE(BigIntOperation::Divide, dividend.size());
+
+    bool quotient_negative = dividend.negative != divisor.negative;
+    bool remainder_negative = dividend.negative;
+    vector<digit_t> rest = dividend.digits;
+    vector<digit_t> result(1, 0);
+
+    if (dividend.size() >= divisor.size()) {
+        result.assign(dividend.size() - divisor.size() + 1, 0);
+        for (size_t offset = result.size(); offset > 0; --offset) {
+            size_t index = offset - 1;
+            digit_t digit = estimate_quotient_digit(rest, divisor.digits, index);
+            if (digit > 0) substract_multiple_shifted(rest, divisor.digits, digit, index);
+            while (greater_or_equal_shifted(rest, divisor.digits, index)) {
+                substract_multiple_shifted(rest, divisor.digits, 1, index);
+                ++digit;
+            }
+            result[index] = digit;
         }
-        substracted.shift(-1);
+        clear_leading_zeroes(result);
     }
-    
-    result.negative = result.is_zero() ? false : (other.negative ^ old_negative);
-    return *this = result;
+    BIGINT_STATS_ALLOCATION(BigIntOperation::Divide, (rest.capacity() + result.capacity()) * sizeof(digit_t));
+
+    quotient.digits = std::move(result);
+    quotient.negative = quotient_negative;
+    quotient.resolve_sign();
+    remainder.digits = std::move(rest);
+    remainder.negative = remainder_negative;
+    remainder.resolve_sign();
+}
+
+void BigInteger::check_random_bound(const BigInteger& bound) {
+    if (bound.is_negative() || bound.is_zero()) throw InvalidArgumentException(bound.toString(), "a positive bound");
+}
+
+BigInteger BigInteger::inverse_modulo_base_power(const BigInteger& value, size_t digits) {
+    size_t lowest = value.is_negative() ? (BASE - value.digits[0]) % BASE : value.digits[0];
+    if (DIGIT_INVERSE[lowest] == 0) throw InvalidArgumentException(value.toString(), "a number coprime with 10");
+
+    // Newton (Hensel) iteration x = x * (2 - value * x) doubles the number of correct digits
+    BigInteger result = DIGIT_INVERSE[lowest];
+    for (size_t precision = 1; precision < digits; ) {
+        precision = std::min(2 * precision, digits);
+        BigInteger correction = value * result;
+        correction.truncate(precision);
+        correction = 2 - correction;
+        result *= correction;
+        result.truncate(precision);
+    }
+    result.truncate(digits);
+    if (result.is_negative()) {
+        BigInteger modulus = 1;
+        modulus.shift(digits);
+        result += modulus;
+    }
+    return result;
+}
+
+int BigInteger::eliminate_lowest_digits(vector<digit_t>& value, const vector<digit_t>& divisor, size_t count, vector<digit_t>* quotient) {
+    // products are subtracted from columns without carrying, only the carry into the next
+    // eliminated digit is needed; a column gets at most count products, so it can't overflow
+    vector<int> columns(value.begin(), value.end());
+    digit_t inverse = DIGIT_INVERSE[static_cast<size_t>(divisor[0])];
+    int carry = 0;
+    for (size_t i = 0; i < count; ++i) {
+        int digit = ((columns[i] + carry) % BASE + BASE) % BASE;
+        digit_t multiplier = digit * inverse % BASE;
+        if (quotient != nullptr) (*quotient)[i] = multiplier;
+        size_t end = std::min(columns.size(), i + divisor.size());
+        for (size_t j = i; j < end; ++j) {
+            columns[j] -= multiplier * divisor[j - i];
+        }
+        // the column is a multiple of BASE now
+        carry = (columns[i] + carry) / BASE;
+        value[i] = 0;
+    }
+    for (size_t i = count; i < columns.size(); ++i) {
+        int current = columns[i] + carry;
+        carry = current / BASE;
+        if (current % BASE < 0) --carry;
+        value[i] = current - carry * BASE;
+    }
+    // nothing but multiples of divisor is subtracted, so the carry out is a borrow
+    return -carry;
+}
+
+bool BigInteger::cancel_factor(BigInteger& divisor, BigInteger& dividend, digit_t factor) {
+    // powers of factor are accumulated while they fit into a word with room for one more digit
+    bool divisible = true;
+    unsigned long long pending = 1;
+    while (divisor.digits[0] % factor == 0) {
+        divisor.divide_word(factor, false);
+        pending *= factor;
+        if (pending > std::numeric_limits<unsigned long long>::max() / BASE / factor) {
+            divisible &= dividend.divide_word(pending, false) == 0;
+            pending = 1;
+        }
+    }
+    if (pending > 1) divisible &= dividend.divide_word(pending, false) == 0;
+    return divisible;
+}
+
+BigInteger BigInteger::divexact(const BigInteger& dividend, const BigInteger& divisor) {
+    if (divisor.is_zero()) throw DivisionByZeroException(dividend);
+    BIGINT_STATS_SCOPE(BigIntOperation::DivideExact, dividend.size());
+
+    BigInteger result = dividend;
+    if (divisor.size() <= WORD_DIGITS) {
+        result.divide_word(divisor.magnitude_word(), divisor.negative);
+        return result;
+    }
+
+    // BASE = 2 * 5, so after cancelling zeroes the divisor has only one of these factors
+    size_t zeroes = divisor.trailing_zeroes();
+    BigInteger odd_part = divisor;
+    odd_part.negative = false;
+    odd_part.shift(-static_cast<int>(zeroes));
+    result.negative = false;
+    result.shift(-static_cast<int>(zeroes));
+    cancel_factor(odd_part, result, 2);
+    cancel_factor(odd_part, result, 5);
+
+    bool result_negative = dividend.negative != divisor.negative;
+    if (odd_part.size() <= WORD_DIGITS) {
+        result.divide_word(odd_part.magnitude_word(), result_negative);
+        return result;
+    }
+    if (result.size() < odd_part.size()) return BigInteger(0);
+
+    // the quotient is less than BASE^quotient_size, so it is the quotient modulo BASE^quotient_size
+    size_t quotient_size = result.size() - odd_part.size() + 1;
+    if (std::min(quotient_size, odd_part.size()) > HENSEL_INVERSE_LIMIT) {
+        result.truncate(quotient_size);
+        result *= inverse_modulo_base_power(odd_part, quotient_size);
+        result.truncate(quotient_size);
+    } else {
+        vector<digit_t> quotient(quotient_size, 0);
+        result.digits.resize(quotient_size);
+        eliminate_lowest_digits(result.digits, odd_part.digits, quotient_size, &quotient);
+        clear_leading_zeroes(quotient);
+        result.digits = std::move(quotient);
+    }
+    result.negative = result_negative;
+    result.resolve_sign();
+    return result;
+}
+
+bool BigInteger::divisible_by(const BigInteger& value, const BigInteger& divisor) {
+    if (divisor.is_zero()) throw DivisionByZeroException(value);
+    if (divisor.size() <= WORD_DIGITS) return value.remainder_word(divisor.magnitude_word()) == 0;
+    if (value.size() < divisor.size()) return value.is_zero();
+
+    size_t zeroes = divisor.trailing_zeroes();
+    if (value.trailing_zeroes() < zeroes) return false;
+    BigInteger rest = value;
+    rest.negative = false;
+    rest.shift(-static_cast<int>(zeroes));
+    BigInteger odd_part = divisor;
+    odd_part.negative = false;
+    odd_part.shift(-static_cast<int>(zeroes));
+    if (!cancel_factor(odd_part, rest, 2) || !cancel_factor(odd_part, rest, 5)) return false;
+
+    if (odd_part.size() <= WORD_DIGITS) return rest.remainder_word(odd_part.magnitude_word()) == 0;
+    if (rest.size() < odd_part.size()) return rest.is_zero();
+
+    // value is divisible iff eliminating the lowest digits leaves nothing
+    size_t count = rest.size() - odd_part.size() + 1;
+    if (std::min(count, odd_part.size()) > HENSEL_INVERSE_LIMIT) {
+        BigInteger quotient = rest;
+        quotient.truncate(count);
+        quotient *= inverse_modulo_base_power(odd_part, count);
+        quotient.truncate(count);
+        return quotient * odd_part == rest;
+    }
+    int borrow = eliminate_lowest_digits(rest.digits, odd_part.digits, count, nullptr);
+    return borrow == 0 && std::all_of(rest.digits.begin(), rest.digits.end(), [](digit_t digit) { return digit == 0; });
+}
+
+BigInteger& BigInteger::operator/=(const BigInteger& other) {
+    BigInteger remainder;
+    divmod(*this, other, *this, remainder);
+    return *this;
 }
 
 BigInteger& BigInteger::operator%=(const BigInteger& other) {
-    auto diff = ((*this) / other);
-    
-    diff *= other;
-    return *this -= diff;
+    BigInteger quotient;
+    divmod(*this, other, quotient, *this);
+    return *this;
 }
 
 BigInteger& BigInteger::operator++() {
@@ -361,32 +1120,310 @@ BigInteger BigInteger::operator-() const {
     return result;
 }
 
-string BigInteger::toString() const {
-    size_t offset = negative ? 1 : 0;
-    string result(size() + offset, '\0');
-    for (size_t i = 0; i < size(); ++i) {
-        result[result.size() - i - 1] = digit_to_char(digits[i]);
+// decimal digits of the magnitude grouped by DECIMAL_GROUP_LENGTH, the highest group first
+constexpr size_t DECIMAL_GROUP_LENGTH = 18;
+constexpr unsigned long long DECIMAL_GROUP_BASE = 1'000'000'000'000'000'000ull;
+
+static vector<unsigned long long> decimal_groups(const BigInteger& value) {
+    vector<unsigned long long> groups((value.size() + DECIMAL_GROUP_LENGTH - 1) / DECIMAL_GROUP_LENGTH, 0);
+    for (size_t i = value.size(); i > 0; --i) {
+        size_t group = groups.size() - 1 - (i - 1) / DECIMAL_GROUP_LENGTH;
+        groups[group] = groups[group] * 10 + value.digit(i - 1);
+    }
+    return groups;
+}
+
+vector<unsigned long long> BigInteger::magnitude_words() const {
+    const unsigned long long group_base = DECIMAL_GROUP_BASE;
+    vector<unsigned long long> groups = decimal_groups(*this);
+
+    // repeatedly divide by 2^64, remainders are the next words
+    vector<unsigned long long> result;
+    size_t first_group = 0;
+    while (first_group < groups.size() && groups[first_group] == 0) ++first_group;
+    while (first_group < groups.size()) {
+        unsigned long long remainder = 0;
+        for (size_t i = first_group; i < groups.size(); ++i) {
+            uint128_t current = static_cast<uint128_t>(remainder) * group_base + groups[i];
+            groups[i] = current >> 64;
+            remainder = static_cast<unsigned long long>(current);
+        }
+        result.push_back(remainder);
+        while (first_group < groups.size() && groups[first_group] == 0) ++first_group;
     }
-    if (negative) result[0] = '-';
     return result;
 }
 
-BigInteger::operator long long() const {
-    if (*this < longMin || longMax < *this) {
-        throw TooBigCastException(*this, typeid(long long));
+BigInteger BigInteger::from_magnitude_words(std::span<const unsigned long long> words, bool negative) {
+    // Horner's scheme by 32-bit halves of words over groups of 9 decimal digits, the lowest group first
+    const unsigned long long group_base = 1'000'000'000;
+    const size_t group_length = 9;
+    vector<unsigned long long> groups;
+    for (size_t i = 2 * words.size(); i > 0; --i) {
+        unsigned long long carry = (words[(i - 1) / 2] >> (32 * ((i - 1) % 2))) & 0xffffffffull;
+        for (auto& group : groups) {
+            unsigned long long current = (group << 32) + carry;
+            group = current % group_base;
+            carry = current / group_base;
+        }
+        for (; carry > 0; carry /= group_base) {
+            groups.push_back(carry % group_base);
+        }
+    }
+
+    BigInteger result;
+    result.digits.assign(std::max<size_t>(groups.size() * group_length, 1), 0);
+    for (size_t i = 0; i < groups.size(); ++i) {
+        for (size_t j = 0; j < group_length; ++j, groups[i] /= BASE) {
+            result.digits[i * group_length + j] = groups[i] % BASE;
+        }
+    }
+    clear_leading_zeroes(result.digits);
+    result.negative = negative;
+    result.resolve_sign();
+    return result;
+}
+
+size_t BigInteger::bit_length() const {
+    auto words = magnitude_words();
+    if (words.empty()) return 0;
+    return (words.size() - 1) * 64 + std::bit_width(words.back());
+}
+
+size_t BigInteger::popcount() const {
+    size_t result = 0;
+    for (auto word : magnitude_words()) {
+        result += std::popcount(word);
+    }
+    return result;
+}
+
+// index of the lowest set bit in nonempty words of a nonzero magnitude
+static size_t lowest_set_bit(const vector<unsigned long long>& words) {
+    size_t index = 0;
+    while (words[index] == 0) ++index;
+    return index * 64 + std::countr_zero(words[index]);
+}
+
+size_t BigInteger::countr_zero() const {
+    if (is_zero()) throw InvalidArgumentException(toString(), "a nonzero value");
+    return lowest_set_bit(magnitude_words());
+}
+
+bool BigInteger::test_bit(size_t index) const {
+    auto words = magnitude_words();
+    auto magnitude_bit = [&](size_t bit) {
+        return bit / 64 < words.size() && ((words[bit / 64] >> (bit % 64)) & 1);
+    };
+    if (!negative) return magnitude_bit(index);
+
+    // -m = ~m + 1: the trailing zeroes and the lowest set bit stay, the higher bits are inverted
+    size_t lowest = lowest_set_bit(words);
+    return index == lowest || (index > lowest && !magnitude_bit(index));
+}
+
+// words of -value modulo 2^(64 * words.size())
+static void negate_words(vector<unsigned long long>& words) {
+    unsigned long long carry = 1;
+    for (auto& word : words) {
+        word = ~word + carry;
+        carry = carry && word == 0;
+    }
+}
+
+// one more word than the longer operand keeps the sign of the result
+template<typename Operation>
+static BigInteger bitwise(const BigInteger& left, const BigInteger& right, Operation operation) {
+    auto result = left.magnitude_words();
+    auto other = right.magnitude_words();
+    size_t length = std::max(result.size(), other.size()) + 1;
+    result.resize(length, 0);
+    other.resize(length, 0);
+    if (left.is_negative()) negate_words(result);
+    if (right.is_negative()) negate_words(other);
+
+    for (size_t i = 0; i < length; ++i) {
+        result[i] = operation(result[i], other[i]);
+    }
+    bool negative = result.back() >> 63;
+    if (negative) negate_words(result);
+    return BigInteger::from_magnitude_words(result, negative);
+}
+
+BigInteger& BigInteger::operator&=(const BigInteger& other) {
+    return *this = *this & other;
+}
+
+BigInteger& BigInteger::operator|=(const BigInteger& other) {
+    return *this = *this | other;
+}
+
+BigInteger& BigInteger::operator^=(const BigInteger& other) {
+    return *this = *this ^ other;
+}
+
+BigInteger BigInteger::operator~() const {
+    BigInteger result = -*this;
+    --result;
+    return result;
+}
+
+static void check_radix(int base) {
+    if (base < 2 || base > 36) throw InvalidArgumentException(std::to_string(base), "a base from 2 to 36");
+}
+
+// value of a digit character in base (letters in any case), or base if c is not a digit
+static int radix_digit_value(char c, int base) {
+    int value = base;
+    if (c >= '0' && c <= '9') value = c - '0';
+    if (c >= 'a' && c <= 'z') value = c - 'a' + 10;
+    if (c >= 'A' && c <= 'Z') value = c - 'A' + 10;
+    return std::min(value, base);
+}
+
+// the biggest power of base which fits into a word, and its exponent
+static std::pair<unsigned long long, size_t> radix_chunk(int base) {
+    unsigned long long power = base;
+    size_t length = 1;
+    while (power <= std::numeric_limits<unsigned long long>::max() / base) {
+        power *= base;
+        ++length;
     }
+    return {power, length};
+}
 
-    long long result = 0;
-    long long power = 1;
-    for(size_t i = 0; i < size(); ++i) {
-        result += digits[i] * power;
-        power *= BASE;
+// sum of chunks[i] * chunk_power^i, where powers[j] = chunk_power^(2^j) are extended as needed
+static BigInteger join_chunks(std::span<const unsigned long long> chunks, unsigned long long chunk_power, vector<BigInteger>& powers) {
+    if (chunks.size() <= RADIX_HORNER_LIMIT) {
+        BigInteger result = 0;
+        for (size_t i = chunks.size(); i > 0; --i) {
+            result *= chunk_power;
+            result += chunks[i - 1];
+        }
+        return result;
     }
-    if (is_negative()) result *= -1;
 
+    // the lower part has 2^level chunks, which is at least a half of them
+    size_t level = std::bit_width(chunks.size() - 1) - 1;
+    size_t half = static_cast<size_t>(1) << level;
+    while (powers.size() <= level) {
+        powers.push_back(powers.back() * powers.back());
+    }
+    BigInteger result = join_chunks(chunks.subspan(half), chunk_power, powers);
+    result *= powers[level];
+    result += join_chunks(chunks.first(half), chunk_power, powers);
     return result;
 }
 
+// magnitude given by characters of digits in base (the highest first), which are checked already
+static BigInteger parse_radix(std::string_view source, int base) {
+    auto [chunk_power, chunk_length] = radix_chunk(base);
+    vector<unsigned long long> chunks((source.size() + chunk_length - 1) / chunk_length, 0);
+    for (size_t i = 0; i < source.size(); ++i) {
+        auto& chunk = chunks[(source.size() - 1 - i) / chunk_length];
+        chunk = chunk * base + radix_digit_value(source[i], base);
+    }
+    vector<BigInteger> powers(1, BigInteger(chunk_power));
+    return join_chunks(chunks, chunk_power, powers);
+}
+
+// digits of the magnitude in base by chunks of radix_chunk(base).second digits, the lowest first, with no zero
+// chunks on top (so none for zero). Chunks in a power of two base are sliced from binary words, other bases
+// take repeated divisions of the decimal groups by a power of base
+static vector<unsigned long long> radix_chunks(const BigInteger& value, int base) {
+    vector<unsigned long long> chunks;
+    if (value.is_zero()) return chunks;
+    auto [chunk_power, chunk_length] = radix_chunk(base);
+
+    if (std::has_single_bit(static_cast<unsigned>(base))) {
+        size_t chunk_bits = chunk_length * std::countr_zero(static_cast<unsigned>(base));
+        auto words = value.magnitude_words();
+        size_t bits_count = 64 * (words.size() - 1) + std::bit_width(words.back());
+        chunks.resize((bits_count + chunk_bits - 1) / chunk_bits);
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            size_t bit = i * chunk_bits;
+            size_t word = bit / 64;
+            size_t shift = bit % 64;
+            unsigned long long chunk = words[word] >> shift;
+            if (shift + chunk_bits > 64 && word + 1 < words.size()) chunk |= words[word + 1] << (64 - shift);
+            chunks[i] = chunk & (chunk_power - 1);
+        }
+        return chunks;
+    }
+
+    vector<unsigned long long> groups = decimal_groups(value);
+    size_t first_group = 0;
+    while (first_group < groups.size()) {
+        unsigned long long remainder = 0;
+        for (size_t i = first_group; i < groups.size(); ++i) {
+            uint128_t current = static_cast<uint128_t>(remainder) * DECIMAL_GROUP_BASE + groups[i];
+            groups[i] = static_cast<unsigned long long>(current / chunk_power);
+            remainder = static_cast<unsigned long long>(current % chunk_power);
+        }
+        chunks.push_back(remainder);
+        while (first_group < groups.size() && groups[first_group] == 0) ++first_group;
+    }
+    return chunks;
+}
+
+// number of characters of the digits in chunks
+static size_t radix_length(const vector<unsigned long long>& chunks, int base) {
+    if (chunks.empty()) return 1;
+    size_t length = (chunks.size() - 1) * radix_chunk(base).second;
+    for (unsigned long long top = chunks.back(); top > 0; top /= base) ++length;
+    return length;
+}
+
+// writes radix_length(chunks, base) characters of the digits in chunks to first, the highest first
+static void write_radix(const vector<unsigned long long>& chunks, int base, char* first) {
+    char* position = first + radix_length(chunks, base);
+    if (chunks.empty()) *--position = '0';
+    size_t chunk_length = radix_chunk(base).second;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        // the highest chunk has no leading zeroes
+        unsigned long long chunk = chunks[i];
+        for (size_t j = 0; j < chunk_length && (chunk > 0 || i + 1 < chunks.size()); ++j, chunk /= base) {
+            *--position = RADIX_DIGITS[chunk % base];
+        }
+    }
+}
+
+// characters of digits of the magnitude in base, the highest first
+static string format_radix(const BigInteger& value, int base) {
+    auto chunks = radix_chunks(value, base);
+    string result(radix_length(chunks, base), '0');
+    write_radix(chunks, base, result.data());
+    return result;
+}
+
+void BigInteger::write_chars(char* first) const {
+    if (negative) *first++ = '-';
+    // stores to char may alias digits, so the bounds are read once
+    const digit_t* begin = digits.data();
+    for (const digit_t* digit = begin + size(); digit != begin; ) {
+        *first++ = digit_to_char(*--digit);
+    }
+}
+
+string BigInteger::toString(int base) const {
+    BIGINT_STATS_SCOPE(BigIntOperation::ToString, size());
+    string result;
+    if (base == 10) {
+        result.resize(formatted_size(*this));
+        write_chars(result.data());
+    } else {
+        check_radix(base);
+        if (negative) result += '-';
+        result += format_radix(*this, base);
+    }
+    BIGINT_STATS_ALLOCATION(BigIntOperation::ToString, result.capacity());
+    return result;
+}
+
+BigInteger::operator long long() const {
+    return to<long long>();
+}
+
 BigInteger::operator bool() const {
     return !is_zero();
 }
@@ -402,17 +1439,23 @@ void BigInteger::invert_sign() {
 }
 
 BigInteger BigInteger::power(const BigInteger& indicator, const BigInteger& exponent) {
-    BigInteger current_power = indicator;
+    // left-to-right by decimal digits of exponent: result^10 takes three squarings
+    // and one multiplication instead of nine multiplications
+    digit_t max_digit = *std::max_element(exponent.digits.begin(), exponent.digits.end());
+    vector<BigInteger> indicator_powers(1, 1);
+    for (digit_t t = 0; t < max_digit; ++t) {
+        indicator_powers.push_back(indicator_powers.back() * indicator);
+    }
+
     BigInteger result = 1;
-    for (auto digit : exponent.digits) {
-        for (auto t = 0; t < digit; ++t) {
-            result *= current_power;
-        }
-        BigInteger new_power = current_power;
-        for (auto t = 1; t < BASE; ++t) {
-            new_power *= current_power;
+    for (size_t i = exponent.size(); i > 0; --i) {
+        if (result != 1) {
+            BigInteger square = result * result;
+            BigInteger fifth = square * square;
+            fifth *= result;
+            result = fifth * fifth;
         }
-        current_power = new_power;
+        result *= indicator_powers[static_cast<size_t>(exponent.digits[i - 1])];
     }
     return result;
 }
@@ -452,6 +1495,18 @@ BigInteger operator%(const BigInteger& left, const BigInteger& right) {
     return result %= right;
 }
 
+BigInteger operator&(const BigInteger& left, const BigInteger& right) {
+    return bitwise(left, right, std::bit_and<unsigned long long>());
+}
+
+BigInteger operator|(const BigInteger& left, const BigInteger& right) {
+    return bitwise(left, right, std::bit_or<unsigned long long>());
+}
+
+BigInteger operator^(const BigInteger& left, const BigInteger& right) {
+    return bitwise(left, right, std::bit_xor<unsigned long long>());
+}
+
 std::istream& operator>>(std::istream& input, BigInteger& value) {
     string data;
     input >> data;
@@ -459,9 +1514,103 @@ std::istream& operator>>(std::istream& input, BigInteger& value) {
     return input;
 }
 
+// operator<< writes digits by chunks of this size
+constexpr size_t STREAM_CHUNK = 256;
+
 std::ostream& operator<<(std::ostream& output, const BigInteger& value) {
-    output << value.toString();
-    return output;
+    std::ios_base::fmtflags flags = output.flags();
+    std::ios_base::fmtflags basefield = flags & std::ios_base::basefield;
+    int base = basefield == std::ios_base::hex ? 16 : basefield == std::ios_base::oct ? 8 : 10;
+    string sign = value.is_negative() ? "-" : (flags & std::ios_base::showpos) && base == 10 ? "+" : "";
+
+    if (base == 10 && output.width() <= 0) {
+        BIGINT_STATS_SCOPE(BigIntOperation::ToString, value.size());
+        char buffer[STREAM_CHUNK];
+        output << sign;
+        for (size_t position = value.size(); position > 0; ) {
+            size_t length = std::min(STREAM_CHUNK, position);
+            for (size_t i = 0; i < length; ++i) {
+                buffer[i] = static_cast<char>('0' + value.digit(position - 1 - i));
+            }
+            output.write(buffer, length);
+            position -= length;
+        }
+        return output;
+    }
+
+    // the prefix and the padding follow the rules for the built-in integers
+    string digits = base == 10 ? value.toString() : format_radix(value, base);
+    if (base == 10 && value.is_negative()) digits.erase(0, 1);
+    bool uppercase = flags & std::ios_base::uppercase;
+    if (uppercase) std::ranges::transform(digits, digits.begin(), [](char c) { return static_cast<char>(std::toupper(c)); });
+    if ((flags & std::ios_base::showbase) && !value.is_zero()) {
+        if (base == 16) sign += uppercase ? "0X" : "0x";
+        if (base == 8) sign += '0';
+    }
+
+    size_t length = sign.size() + digits.size();
+    size_t padding = output.width() > 0 ? std::max(static_cast<size_t>(output.width()), length) - length : 0;
+    output.width(0);
+    std::ios_base::fmtflags adjustment = flags & std::ios_base::adjustfield;
+    string fill(padding, output.fill());
+    if (adjustment == std::ios_base::left) return output << sign << digits << fill;
+    if (adjustment == std::ios_base::internal) return output << sign << fill << digits;
+    return output << fill << sign << digits;
+}
+
+size_t formatted_size(const BigInteger& value, int base) {
+    size_t sign_size = value.is_negative() ? 1 : 0;
+    if (base == 10) return value.size() + sign_size;
+    check_radix(base);
+    if (std::has_single_bit(static_cast<unsigned>(base)) && !value.is_zero()) {
+        size_t digit_bits = std::countr_zero(static_cast<unsigned>(base));
+        return (value.bit_length() + digit_bits - 1) / digit_bits + sign_size;
+    }
+    return radix_length(radix_chunks(value, base), base) + sign_size;
+}
+
+std::to_chars_result to_chars(char* first, char* last, const BigInteger& value, int base) {
+    BIGINT_STATS_SCOPE(BigIntOperation::ToString, value.size());
+    if (base != 10) {
+        check_radix(base);
+        auto chunks = radix_chunks(value, base);
+        size_t length = radix_length(chunks, base) + (value.is_negative() ? 1 : 0);
+        if (static_cast<size_t>(last - first) < length) return {last, std::errc::value_too_large};
+        if (value.is_negative()) *first = '-';
+        write_radix(chunks, base, first + (value.is_negative() ? 1 : 0));
+        return {first + length, std::errc()};
+    }
+
+    size_t length = formatted_size(value);
+    if (static_cast<size_t>(last - first) < length) return {last, std::errc::value_too_large};
+    value.write_chars(first);
+    return {first + length, std::errc()};
+}
+
+std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value, int base) {
+    check_radix(base);
+    bool negative = first != last && *first == '-';
+    const char* begin = negative ? first + 1 : first;
+    const char* end = begin;
+    while (end != last && radix_digit_value(*end, base) < base) ++end;
+    if (begin == end) return {first, std::errc::invalid_argument};
+
+    if (base != 10) {
+        value = parse_radix(std::string_view(begin, end - begin), base);
+        if (negative) value.invert_sign();
+        return {end, std::errc()};
+    }
+
+    while (end - begin > 1 && *begin == '0') ++begin;
+    // the characters are checked already
+    value.digits.resize(end - begin);
+    const char* position = end;
+    for (digit_t& digit : value.digits) {
+        digit = static_cast<digit_t>(*--position - '0');
+    }
+    value.negative = negative;
+    value.resolve_sign();
+    return {end, std::errc()};
 }
 
 strong_ordering operator<=>(const BigInteger& left, const BigInteger& right) {
@@ -474,14 +1623,8 @@ strong_ordering operator<=>(const BigInteger& left, const BigInteger& right) {
     }
 }
 
-BigInteger operator""_bi(unsigned long long source) {
-    BigInteger result = static_cast<long long>(source / 2);
-    result *= 2;
-    result += static_cast<int>(source % 2);
-    return result;
-}
-
 BigInteger gcd(BigInteger left, BigInteger right) {
+    BIGINT_STATS_SCOPE(BigIntOperation::Gcd, std::max(left.size(), right.size()));
     BigInteger* big = &left;
     BigInteger* small = &right;
 
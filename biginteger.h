@@ -1,10 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <charconv>
 #include <compare>
 #include <complex>
+#include <concepts>
+#include <functional>
 #include <vector>
 #include <string>
 #include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <string_view>
+#include <typeinfo>
 
 using std::vector;
 using std::string;
@@ -12,9 +22,15 @@ using std::strong_ordering;
 
 using digit_t = char;
 using complex = std::complex<long double>;
+__extension__ typedef __int128 int128_t;
+__extension__ typedef unsigned __int128 uint128_t;
 
 size_t revert_binary(size_t index, size_t length);
 
+// built-in integer types except bool, and the 128-bit ones, which are not std::integral in the strict mode
+template<typename T>
+concept native_integer = (std::integral<T> && !std::same_as<T, bool>) || std::same_as<T, int128_t> || std::same_as<T, uint128_t>;
+
 class BigInteger {
   private:
     static const digit_t BASE = 10;
@@ -31,14 +47,30 @@ class BigInteger {
     // Applies Fast Fourier Transform (or it's inversed form) to the vector of coefficients (or values respectively)
     static void fft(vector<complex>& coefficients, bool inversed=false);
     
-    static vector<digit_t> complex_to_digits(const vector<complex>& values);
+    static vector<digit_t> complex_to_digits(const vector<complex>& values, bool imaginary=false);
+
+    // power of two big enough for a product of target_size digits
+    static size_t fft_size(size_t target_size);
 
-    static vector<complex> digits_to_complex(const vector<digit_t>& values, size_t target_size); 
+    // coefficients real_part + i * imaginary_part padded for their product
+    static void digits_to_complex(const vector<digit_t>& real_part, const vector<digit_t>& imaginary_part, vector<complex>& result);
+
+    // turns the transform of a + i * b into the transform of a * b
+    static void packed_product_spectrum(vector<complex>& values);
 
     static void clear_leading_zeroes(vector<digit_t>& digits);
 
     static void reorder_for_fft(vector<complex>& source);
 
+    // checks that value >= other * BASE^offset, value must not have leading zeroes
+    static bool greater_or_equal_shifted(const vector<digit_t>& value, const vector<digit_t>& other, size_t offset);
+
+    // contract: value >= other * multiplier * BASE^offset
+    static void substract_multiple_shifted(vector<digit_t>& value, const vector<digit_t>& other, digit_t multiplier, size_t offset);
+
+    // estimates (from below) the next quotient digit of value / (other * BASE^offset)
+    static digit_t estimate_quotient_digit(const vector<digit_t>& value, const vector<digit_t>& other, size_t offset);
+
 
     void add_absolute(const BigInteger& other);
 
@@ -50,17 +82,230 @@ class BigInteger {
 
     void resolve_sign();
 
+    void assign_magnitude(unsigned long long value);
+
+    void assign_magnitude(uint128_t value);
+
+    // Kernels for native integer operands, which are passed as magnitude and sign,
+    // so that they never become temporary BigIntegers
+
+    template<std::integral T>
+    static bool is_negative_value(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            return value < 0;
+        } else {
+            return false;
+        }
+    }
+
+    // unsigned negation works for the minimal value as well
+    template<std::integral T>
+    static unsigned long long magnitude_of(T value) {
+        auto result = static_cast<unsigned long long>(value);
+        return is_negative_value(value) ? 0ull - result : result;
+    }
+
+    void add_word(unsigned long long magnitude, bool operand_negative);
+
+    void multiply_word(unsigned long long magnitude, bool operand_negative);
+
+    // leaves the quotient (rounded towards zero) and returns the magnitude of the remainder
+    unsigned long long divide_word(unsigned long long magnitude, bool operand_negative);
+
+    // magnitude of the remainder, which has the sign of this
+    unsigned long long remainder_word(unsigned long long magnitude) const;
+
+    strong_ordering compare_magnitude_word(unsigned long long magnitude) const;
+
+    strong_ordering compare_word(unsigned long long magnitude, bool operand_negative) const;
+
+    // magnitude of a number which fits into unsigned long long
+    unsigned long long magnitude_word() const;
+
+    size_t trailing_zeroes() const;
+
+    // magnitude if it fits into 128 bits
+    std::optional<uint128_t> wide_magnitude() const;
+
+    // the biggest magnitude of a value of type T with the given sign
+    template<native_integer T>
+    static constexpr uint128_t max_magnitude(bool negative) {
+        constexpr bool is_signed = static_cast<T>(-1) < static_cast<T>(0);
+        constexpr size_t value_bits = sizeof(T) * 8 - is_signed;
+        constexpr uint128_t positive_limit = value_bits == 128 ? ~static_cast<uint128_t>(0)
+            : (static_cast<uint128_t>(1) << value_bits) - 1;
+        if (!negative) return positive_limit;
+        return is_signed ? positive_limit + 1 : 0;
+    }
+
+    [[noreturn]] void throw_cast_exception(const std::type_info& cast_type, bool to_unsigned) const;
+
+    // Hensel elimination: for each of count lowest positions i subtracts such multiple of divisor * BASE^i
+    // that the i-th digit becomes zero, divisor must be coprime with BASE. The multipliers are written
+    // to quotient unless it is null, digits beyond value.size() are dropped and the borrow out of them is returned
+    static int eliminate_lowest_digits(vector<digit_t>& value, const vector<digit_t>& divisor, size_t count, vector<digit_t>* quotient);
+
+    // product of magnitudes by one packed transform
+    static vector<digit_t> multiply_magnitudes(const vector<digit_t>& left, const vector<digit_t>& right);
+
+    // adds (or substracts) value * multiplier * BASE^offset to the magnitude modulo BASE^size(),
+    // multiplier must be less than BASE^SCALED_MULTIPLIER_DIGITS; returns whether there was a borrow out
+    bool accumulate_scaled(const vector<digit_t>& value, unsigned long long multiplier, size_t offset, bool substract);
+
+    // makes room for a product of product_size digits, so that adding it can't carry out
+    void begin_accumulation(size_t product_size);
+
+    // a borrow out means the magnitude became BASE^size() minus the real one of the opposite sign
+    void finish_accumulation(bool borrowed);
+
+    // this += value * magnitude (or -= if product_negative)
+    void add_product_word(const BigInteger& value, unsigned long long magnitude, bool product_negative);
+
+    // this += left * right (or -= if substract)
+    void add_product(const BigInteger& left, const BigInteger& right, bool substract);
+
+    // divides divisor by factor while possible and dividend by the same power of factor,
+    // returns whether dividend was divisible by that power
+    static bool cancel_factor(BigInteger& divisor, BigInteger& dividend, digit_t factor);
+
+    // random digits are taken by chunks of this many from uniformly random words
+    static constexpr size_t RANDOM_CHUNK_DIGITS = 18;
+    static constexpr unsigned long long RANDOM_CHUNK_BASE = 1'000'000'000'000'000'000ull;
+
+    // writes count uniformly random digits to digits
+    template<std::uniform_random_bit_generator Generator>
+    static void fill_random_digits(Generator& generator, digit_t* digits, size_t count) {
+        std::uniform_int_distribution<unsigned long long> chunk_distribution(0, RANDOM_CHUNK_BASE - 1);
+        for (size_t position = 0; position < count; position += RANDOM_CHUNK_DIGITS) {
+            unsigned long long chunk = chunk_distribution(generator);
+            for (size_t i = position; i < std::min(count, position + RANDOM_CHUNK_DIGITS); ++i, chunk /= BASE) {
+                digits[i] = chunk % BASE;
+            }
+        }
+    }
+
+    // throws InvalidArgumentException unless bound is positive
+    static void check_random_bound(const BigInteger& bound);
+
+    template<std::uniform_random_bit_generator Generator>
+    static void assign_random_below(Generator& generator, const BigInteger& bound, BigInteger& result) {
+        // the highest digits of bound (at most a chunk of them) make the range of the highest digits of result
+        // and the lowest ones are uniform, so result is rejected (as not below bound) with probability
+        // less than BASE^(1 - top_length) unless bound is short
+        size_t top_length = std::min(bound.size(), RANDOM_CHUNK_DIGITS);
+        size_t low_length = bound.size() - top_length;
+        unsigned long long top_bound = 0;
+        for (size_t i = bound.size(); i > low_length; --i) {
+            top_bound = top_bound * BASE + bound.digits[i - 1];
+        }
+        std::uniform_int_distribution<unsigned long long> top_distribution(0, top_bound);
+
+        result.digits.resize(bound.size());
+        result.negative = false;
+        do {
+            fill_random_digits(generator, result.digits.data(), low_length);
+            unsigned long long top = top_distribution(generator);
+            for (size_t i = low_length; i < bound.size(); ++i, top /= BASE) {
+                result.digits[i] = top % BASE;
+            }
+        } while (result.compare_absolute(bound) != strong_ordering::less);
+        clear_leading_zeroes(result.digits);
+    }
+
+    // Integer literals are parsed by the compiler, so a _bi constant costs a single copy of ready digits
+
+    // digits of a literal, the lowest one first; size is the number of significant ones
+    template<size_t Capacity>
+    struct LiteralDigits {
+        std::array<digit_t, Capacity> digits{};
+        size_t size = 0;
+    };
+
+    // a literal of length characters has at most this many digits in BASE (a hexadecimal digit gives less than 1.25)
+    static constexpr size_t literal_capacity(size_t length) {
+        return length + length / 4 + 1;
+    }
+
+    // accepts everything that makes an integer literal: decimal, 0x, 0b and octal forms with ' separators
+    template<size_t Capacity>
+    static consteval LiteralDigits<Capacity> parse_literal(std::string_view literal) {
+        digit_t radix = 10;
+        if (literal.size() > 1 && literal[0] == '0') {
+            if (literal[1] == 'x' || literal[1] == 'X') {
+                radix = 16;
+            } else if (literal[1] == 'b' || literal[1] == 'B') {
+                radix = 2;
+            } else {
+                radix = 8;
+            }
+            literal.remove_prefix(radix == 8 ? 1 : 2);
+        }
+
+        LiteralDigits<Capacity> result;
+        for (char c : literal) {
+            if (c == '\'') continue;
+            int carry = c >= '0' && c <= '9' ? c - '0'
+                : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                : c >= 'A' && c <= 'F' ? c - 'A' + 10 : radix;
+            if (carry >= radix) throw "invalid digit in a _bi literal";
+            for (size_t i = 0; i < result.size; ++i) {
+                carry += result.digits[i] * radix;
+                result.digits[i] = carry % BASE;
+                carry /= BASE;
+            }
+            for (; carry > 0; carry /= BASE) {
+                result.digits[result.size++] = carry % BASE;
+            }
+        }
+        if (result.size == 0) ++result.size;
+        return result;
+    }
+
+    // digits must have no leading zeroes
+    BigInteger(vector<digit_t>&& digits, bool negative);
+
+    static BigInteger from_literal_digits(std::span<const digit_t> source);
+
+    template<char... Chars>
+    friend BigInteger operator""_bi();
+
+    // writes formatted_size() characters of the decimal form to first
+    void write_chars(char* first) const;
+
   public:
     BigInteger();
 
+    BigInteger(int value);
+
+    BigInteger(long value);
+
     BigInteger(long long value);
 
+    BigInteger(unsigned value);
+
+    BigInteger(unsigned long value);
+
+    BigInteger(unsigned long long value);
+
+    BigInteger(int128_t value);
+
+    BigInteger(uint128_t value);
+
     BigInteger(const BigInteger& source);
 
+    // source is left equal to zero
+    BigInteger(BigInteger&& source) noexcept;
+
     explicit BigInteger(const string& source);
 
+    // digits in base from 2 to 36, letters stand for digits from 10 in any case
+    explicit BigInteger(const string& source, int base);
+
     BigInteger& operator=(const BigInteger& source);
 
+    // swaps the values, so source stays valid
+    BigInteger& operator=(BigInteger&& source) noexcept;
+
     BigInteger& operator+=(const BigInteger& other);
 
     BigInteger& operator-=(const BigInteger& other);
@@ -71,6 +316,116 @@ class BigInteger {
 
     BigInteger& operator%=(const BigInteger& other);
 
+    // Native integer operands, these never allocate while the result fits into the current capacity
+
+    template<std::integral T>
+    BigInteger& operator+=(T other) {
+        add_word(magnitude_of(other), is_negative_value(other));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigInteger& operator-=(T other) {
+        add_word(magnitude_of(other), !is_negative_value(other));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigInteger& operator*=(T other) {
+        multiply_word(magnitude_of(other), is_negative_value(other));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigInteger& operator/=(T other) {
+        divide_word(magnitude_of(other), is_negative_value(other));
+        return *this;
+    }
+
+    template<std::integral T>
+    BigInteger& operator%=(T other) {
+        bool was_negative = negative;
+        assign_magnitude(remainder_word(magnitude_of(other)));
+        negative = was_negative;
+        resolve_sign();
+        return *this;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator+(BigInteger left, T right) {
+        left += right;
+        return left;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator+(T left, BigInteger right) {
+        right += left;
+        return right;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator-(BigInteger left, T right) {
+        left -= right;
+        return left;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator-(T left, BigInteger right) {
+        right -= left;
+        right.invert_sign();
+        return right;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator*(BigInteger left, T right) {
+        left *= right;
+        return left;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator*(T left, BigInteger right) {
+        right *= left;
+        return right;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator/(BigInteger left, T right) {
+        left /= right;
+        return left;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator/(T left, const BigInteger& right) {
+        BigInteger result = left;
+        result /= right;
+        return result;
+    }
+
+    // the remainder is at most as long as right, so left is not copied
+    template<std::integral T>
+    friend BigInteger operator%(const BigInteger& left, T right) {
+        BigInteger result = left.remainder_word(magnitude_of(right));
+        if (left.negative) result.invert_sign();
+        return result;
+    }
+
+    template<std::integral T>
+    friend BigInteger operator%(T left, const BigInteger& right) {
+        BigInteger result = left;
+        result %= right;
+        return result;
+    }
+
+    template<std::integral T>
+    friend bool operator==(const BigInteger& left, T right) {
+        return left.compare_word(magnitude_of(right), is_negative_value(right)) == strong_ordering::equal;
+    }
+
+    template<std::integral T>
+    friend strong_ordering operator<=>(const BigInteger& left, T right) {
+        return left.compare_word(magnitude_of(right), is_negative_value(right));
+    }
+
     BigInteger& operator++();
 
     BigInteger operator++(int);
@@ -81,8 +436,61 @@ class BigInteger {
 
     BigInteger operator-() const;
 
-    string toString() const;
-    
+    // Bitwise operations treat values as infinite two's complement, as for built-in signed types.
+    // Every operation converts decimal digits to binary words, which is quadratic in size()
+
+    BigInteger& operator&=(const BigInteger& other);
+
+    BigInteger& operator|=(const BigInteger& other);
+
+    BigInteger& operator^=(const BigInteger& other);
+
+    // -value - 1
+    BigInteger operator~() const;
+
+    // binary digits of the magnitude by 64, the lowest word first, empty for zero
+    vector<unsigned long long> magnitude_words() const;
+
+    static BigInteger from_magnitude_words(std::span<const unsigned long long> words, bool negative=false);
+
+    // number of bits in the magnitude, zero for zero
+    size_t bit_length() const;
+
+    // number of set bits in the magnitude
+    size_t popcount() const;
+
+    // index-th bit of the two's complement representation
+    bool test_bit(size_t index) const;
+
+    // number of trailing zero bits, the same for value and -value; throws for zero
+    size_t countr_zero() const;
+
+    // hash of the digits and the sign, equal values have equal hashes. The digits are read by words
+    // into four independent lanes, so consecutive multiplications don't wait for each other
+    size_t hash() const;
+
+    // digits in base from 2 to 36 with lowercase letters. Decimal output is linear, power of two bases
+    // take a conversion to binary words, other bases take a division by a power of base for each word
+    string toString(int base = 10) const;
+
+    // exact value if it fits into T, nullopt otherwise; the range is decided by the number of digits
+    // and at most one more comparison
+    template<native_integer T>
+    std::optional<T> try_to() const {
+        auto magnitude = wide_magnitude();
+        if (!magnitude || *magnitude > max_magnitude<T>(negative)) return std::nullopt;
+        // conversion of an unsigned value to a signed type is modular
+        return static_cast<T>(negative ? 0 - *magnitude : *magnitude);
+    }
+
+    // throws TooBigCastException or NegativeToUnsignedCastException if the value doesn't fit into T
+    template<native_integer T>
+    T to() const {
+        auto result = try_to<T>();
+        if (!result) throw_cast_exception(typeid(T), max_magnitude<T>(true) == 0);
+        return *result;
+    }
+
     explicit operator long long() const;
 
     explicit operator bool() const;
@@ -97,11 +505,101 @@ class BigInteger {
 
     void shift(int digits);
 
+    // keeps only the lowest digits, that is value % BASE^digits
+    void truncate(size_t digits);
+
+    // index-th digit from the lowest one, zero for indices beyond size()
+    digit_t digit(size_t index) const;
+
     ~BigInteger() = default;
 
     static BigInteger power(const BigInteger& indicator, const BigInteger& exponent);
 
+    // result[i] = left[i] * right[i], products of the same size share transform tables and buffers,
+    // parts of the batch run on threads_count threads.
+    // result may be the same span as left or right, but must not overlap them otherwise
+    static void multiply_batch(std::span<const BigInteger> left, std::span<const BigInteger> right,
+        std::span<BigInteger> result, size_t threads_count=1);
+
+    // quotient is rounded towards zero, remainder has the sign of dividend (as for built-in types)
+    // quotient and remainder may be the same objects as dividend or divisor
+    static void divmod(const BigInteger& dividend, const BigInteger& divisor, BigInteger& quotient, BigInteger& remainder);
+
+    // dividend / divisor for dividend divisible by divisor, the result is unspecified otherwise.
+    // Quotient digits are found from the lowest one (Hensel division), so nothing is estimated or corrected
+    static BigInteger divexact(const BigInteger& dividend, const BigInteger& divisor);
+
+    // checks that divisor divides value, the quotient is not built unless both of them are long
+    static bool divisible_by(const BigInteger& value, const BigInteger& divisor);
+
+    // accumulator += left * right with no temporary for the product: short products are added digit
+    // by digit, so nothing is allocated while the result fits into the capacity of accumulator
+    static void addmul(BigInteger& accumulator, const BigInteger& left, const BigInteger& right);
+
+    // accumulator -= left * right
+    static void submul(BigInteger& accumulator, const BigInteger& left, const BigInteger& right);
+
+    // accumulator += value * multiplier for a native integer multiplier
+    template<std::integral T>
+    static void addmul_1(BigInteger& accumulator, const BigInteger& value, T multiplier) {
+        accumulator.add_product_word(value, magnitude_of(multiplier), is_negative_value(multiplier));
+    }
+
+    // accumulator -= value * multiplier
+    template<std::integral T>
+    static void submul_1(BigInteger& accumulator, const BigInteger& value, T multiplier) {
+        accumulator.add_product_word(value, magnitude_of(multiplier), !is_negative_value(multiplier));
+    }
+
+    // value^(-1) modulo BASE^digits for value coprime with BASE, the result is in [0, BASE^digits)
+    static BigInteger inverse_modulo_base_power(const BigInteger& value, size_t digits);
+
+    // Random values are built from uniformly random words of generator with rejection, so they are
+    // exactly uniform. The digits are written directly, no conversions are involved
+
+    // uniformly random value in [0, bound), throws InvalidArgumentException unless bound is positive
+    template<std::uniform_random_bit_generator Generator>
+    static BigInteger random_below(Generator& generator, const BigInteger& bound) {
+        check_random_bound(bound);
+        BigInteger result;
+        assign_random_below(generator, bound, result);
+        return result;
+    }
+
+    // fills result with independent uniformly random values in [0, bound), reusing their capacity.
+    // bound may be one of the values of result, then it is copied first
+    template<std::uniform_random_bit_generator Generator>
+    static void random_below(Generator& generator, const BigInteger& bound, std::span<BigInteger> result) {
+        check_random_bound(bound);
+        for (const auto& value : result) {
+            if (&value == &bound) {
+                BigInteger copy = bound;
+                random_below(generator, copy, result);
+                return;
+            }
+        }
+        for (auto& value : result) {
+            assign_random_below(generator, bound, value);
+        }
+    }
+
+    // uniformly random value in [0, 2^bits_count). The bound 2^bits_count is built by every call, so many values
+    // are better taken by the overload for spans or by random_below with a bound built once
+    template<std::uniform_random_bit_generator Generator>
+    static BigInteger random_bits(Generator& generator, size_t bits_count) {
+        return random_below(generator, power(2, bits_count));
+    }
+
+    template<std::uniform_random_bit_generator Generator>
+    static void random_bits(Generator& generator, size_t bits_count, std::span<BigInteger> result) {
+        random_below(generator, power(2, bits_count), result);
+    }
+
     friend strong_ordering operator<=>(const BigInteger& left, const BigInteger& right);
+
+    friend std::to_chars_result to_chars(char* first, char* last, const BigInteger& value, int base);
+
+    friend std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value, int base);
 };
 
 bool operator==(const BigInteger& left, const BigInteger& right);
@@ -118,11 +616,47 @@ BigInteger operator/(const BigInteger& left, const BigInteger& right);
 
 BigInteger operator%(const BigInteger& left, const BigInteger& right);
 
+BigInteger operator&(const BigInteger& left, const BigInteger& right);
+
+BigInteger operator|(const BigInteger& left, const BigInteger& right);
+
+BigInteger operator^(const BigInteger& left, const BigInteger& right);
+
 std::istream& operator>>(std::istream& input, BigInteger& value);
 
+// honors the basefield, showbase, showpos, uppercase, width, fill and adjustfield flags like for the built-in
+// integers (showpos only in decimal). Decimal digits with no width go through a buffer on the stack
 std::ostream& operator<<(std::ostream& output, const BigInteger& source);
 
-BigInteger operator""_bi(unsigned long long);
+// Conversions in the manner of std::to_chars and std::from_chars in bases from 2 to 36 (others throw
+// InvalidArgumentException). Nothing is allocated in base 10. Other bases convert the digits into chunks which fit
+// into words first, so formatted_size takes as long as to_chars there (powers of two excepted), and to_chars
+// writes the chunks to the buffer directly
+
+// number of characters in the form of value in base, including the minus sign
+size_t formatted_size(const BigInteger& value, int base = 10);
+
+// errc::value_too_large (and last) if the form of value doesn't fit into [first, last)
+std::to_chars_result to_chars(char* first, char* last, const BigInteger& value, int base = 10);
+
+// reads an optional minus and the longest sequence of digits in base, value is left untouched
+// if there are no digits (errc::invalid_argument); in base 10 value only allocates if it's shorter than the result.
+// Other bases are parsed by chunks which fit into words, long sequences of chunks are joined by halves
+std::from_chars_result from_chars(const char* first, const char* last, BigInteger& value, int base = 10);
+
+template<char... Chars>
+BigInteger operator""_bi() {
+    static constexpr char literal[] = {Chars...};
+    static constexpr auto parsed = BigInteger::parse_literal<BigInteger::literal_capacity(sizeof...(Chars))>(
+        std::string_view(literal, sizeof...(Chars)));
+    return BigInteger::from_literal_digits(std::span<const digit_t>(parsed.digits.data(), parsed.size));
+}
 
 BigInteger gcd(BigInteger left, BigInteger right);
 
+template<>
+struct std::hash<BigInteger> {
+    size_t operator()(const BigInteger& value) const noexcept {
+        return value.hash();
+    }
+};
@@ -13,6 +13,13 @@ const char* InvalidInputException::what() const noexcept {
     return rebuild_c_string_from_string(data);
 }
 
+InvalidArgumentException::InvalidArgumentException(string argument, string requirement) : argument(argument), requirement(requirement) {}
+
+const char* InvalidArgumentException::what() const noexcept {
+    auto data = "Invalid argument: " + argument + ". Expected " + requirement;
+    return rebuild_c_string_from_string(data);
+}
+
 DivisionByZeroException::DivisionByZeroException(const BigInteger& value) : value(value) {}
 
 const char* DivisionByZeroException::what() const noexcept {
@@ -19,6 +19,17 @@ class InvalidInputException: public std::exception {
    const char* what() const noexcept override;
 };
 
+class InvalidArgumentException: public std::exception {
+  private:
+    string argument;
+    string requirement;
+
+  public:
+    InvalidArgumentException(string argument, string requirement);
+
+    const char* what() const noexcept override;
+};
+
 class DivisionByZeroException: public std::exception {
   private:
     BigInteger value;
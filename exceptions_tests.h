@@ -21,6 +21,14 @@ TEST(ExceptionTests, InvalidInput) {
     }
 }
 
+TEST(ExceptionTests, InvalidArgument) {
+    try {
+        throw InvalidArgumentException("-7", "a positive modulus");
+    } catch (std::exception& e) {
+        ASSERT_EQ("Invalid argument: -7. Expected a positive modulus", string(e.what()));
+    }
+}
+
 TEST(ExceptionTests, DivisionByZero) {
     try {
         throw DivisionByZeroException(BigInteger(179));
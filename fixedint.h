@@ -0,0 +1,388 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <iostream>
+#include <string>
+#include <typeinfo>
+
+#include "biginteger.h"
+#include "exceptions.h"
+#include "rational.h"
+
+// Integer of Bits bits with arithmetic modulo 2^Bits, as for built-in types, signed values are
+// in two's complement. The limbs are stored inline and all the loops over them have compile-time
+// bounds, so small widths need no allocations and the operations work in constant expressions.
+// Converting to BigInteger is always exact, converting from BigInteger throws if the value doesn't fit
+template<size_t Bits, bool Signed = true>
+class FixedInt {
+    static_assert(Bits > 0, "FixedInt needs at least one bit");
+
+  public:
+    static const size_t LIMB_BITS = 64;
+    static const size_t LIMBS_COUNT = (Bits + LIMB_BITS - 1) / LIMB_BITS;
+
+  private:
+    using limbs_t = std::array<unsigned long long, LIMBS_COUNT>;
+
+    // the lowest limb first, bits of the highest limb beyond Bits are always zero
+    limbs_t limbs{};
+
+    static constexpr unsigned long long HIGHEST_LIMB_MASK =
+        Bits % LIMB_BITS == 0 ? ~0ull : (1ull << (Bits % LIMB_BITS)) - 1;
+
+    constexpr void normalize() {
+        limbs[LIMBS_COUNT - 1] &= HIGHEST_LIMB_MASK;
+    }
+
+    // fills the limbs with value extended by its sign
+    constexpr void assign_extended(uint128_t value, bool value_negative) {
+        limbs[0] = static_cast<unsigned long long>(value);
+        for (size_t i = 1; i < LIMBS_COUNT; ++i) {
+            limbs[i] = i == 1 ? static_cast<unsigned long long>(value >> LIMB_BITS) : (value_negative ? ~0ull : 0);
+        }
+        normalize();
+    }
+
+    static constexpr int compare_limbs(const limbs_t& left, const limbs_t& right) {
+        for (size_t i = LIMBS_COUNT; i > 0; --i) {
+            if (left[i - 1] != right[i - 1]) return left[i - 1] < right[i - 1] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    static constexpr size_t significant_limbs(const limbs_t& value) {
+        size_t result = LIMBS_COUNT;
+        while (result > 0 && value[result - 1] == 0) --result;
+        return result;
+    }
+
+    // quotient and remainder of unsigned values, Knuth's algorithm D with 64-bit limbs
+    static constexpr void divide_unsigned(const limbs_t& dividend, const limbs_t& divisor, limbs_t& quotient, limbs_t& remainder) {
+        quotient = limbs_t{};
+        remainder = limbs_t{};
+        size_t divisor_size = significant_limbs(divisor);
+        size_t dividend_size = significant_limbs(dividend);
+        if (compare_limbs(dividend, divisor) < 0) {
+            remainder = dividend;
+            return;
+        }
+
+        if (divisor_size == 1) {
+            unsigned long long rest = 0;
+            for (size_t i = dividend_size; i > 0; --i) {
+                uint128_t current = (static_cast<uint128_t>(rest) << LIMB_BITS) | dividend[i - 1];
+                quotient[i - 1] = static_cast<unsigned long long>(current / divisor[0]);
+                rest = static_cast<unsigned long long>(current % divisor[0]);
+            }
+            remainder[0] = rest;
+            return;
+        }
+
+        // a single limb is always handled above
+        if constexpr (LIMBS_COUNT > 1) {
+            // normalization makes the highest divisor limb at least 2^63, so that quotient estimations are off by at most 2
+            int shift = std::countl_zero(divisor[divisor_size - 1]);
+            std::array<unsigned long long, LIMBS_COUNT> normalized_divisor{};
+            std::array<unsigned long long, LIMBS_COUNT + 1> rest{};
+            for (size_t i = 0; i < LIMBS_COUNT; ++i) {
+                normalized_divisor[i] = (divisor[i] << shift) | (shift > 0 && i > 0 ? divisor[i - 1] >> (LIMB_BITS - shift) : 0);
+                rest[i] = (dividend[i] << shift) | (shift > 0 && i > 0 ? dividend[i - 1] >> (LIMB_BITS - shift) : 0);
+            }
+            rest[LIMBS_COUNT] = shift > 0 ? dividend[LIMBS_COUNT - 1] >> (LIMB_BITS - shift) : 0;
+
+            unsigned long long top = normalized_divisor[divisor_size - 1];
+            unsigned long long next = normalized_divisor[divisor_size - 2];
+            for (size_t j = dividend_size - divisor_size + 1; j > 0; --j) {
+                size_t offset = j - 1;
+                uint128_t numerator = (static_cast<uint128_t>(rest[offset + divisor_size]) << LIMB_BITS) | rest[offset + divisor_size - 1];
+                uint128_t estimate = numerator / top;
+                uint128_t estimate_rest = numerator % top;
+                while (estimate >> LIMB_BITS ||
+                        estimate * next > ((estimate_rest << LIMB_BITS) | rest[offset + divisor_size - 2])) {
+                    --estimate;
+                    estimate_rest += top;
+                    if (estimate_rest >> LIMB_BITS) break;
+                }
+
+                // rest -= estimate * normalized_divisor * 2^(64 * offset)
+                unsigned long long carry = 0;
+                unsigned long long borrow = 0;
+                for (size_t i = 0; i <= divisor_size; ++i) {
+                    uint128_t product = (i < divisor_size ? estimate * normalized_divisor[i] : 0) + carry;
+                    carry = static_cast<unsigned long long>(product >> LIMB_BITS);
+                    unsigned long long low = static_cast<unsigned long long>(product);
+                    unsigned long long current = rest[offset + i];
+                    rest[offset + i] = current - low - borrow;
+                    borrow = current < low || current - low < borrow;
+                }
+                // the estimate was one too big, add the divisor back
+                if (borrow) {
+                    --estimate;
+                    unsigned long long add_carry = 0;
+                    for (size_t i = 0; i <= divisor_size; ++i) {
+                        uint128_t sum = static_cast<uint128_t>(rest[offset + i]) + (i < divisor_size ? normalized_divisor[i] : 0) + add_carry;
+                        rest[offset + i] = static_cast<unsigned long long>(sum);
+                        add_carry = static_cast<unsigned long long>(sum >> LIMB_BITS);
+                    }
+                }
+                quotient[offset] = static_cast<unsigned long long>(estimate);
+            }
+
+            for (size_t i = 0; i < LIMBS_COUNT; ++i) {
+                remainder[i] = (rest[i] >> shift) | (shift > 0 ? rest[i + 1] << (LIMB_BITS - shift) : 0);
+            }
+        }
+    }
+
+    // truncating division with the remainder of the dividend's sign, as for built-in types;
+    // quotient and remainder may be the same objects as dividend or divisor
+    static constexpr void divmod(const FixedInt& dividend, const FixedInt& divisor, FixedInt& quotient, FixedInt& remainder) {
+        if (divisor.is_zero()) throw DivisionByZeroException(BigInteger(dividend));
+        bool dividend_negative = dividend.is_negative();
+        bool quotient_negative = dividend_negative != divisor.is_negative();
+        FixedInt dividend_magnitude = dividend_negative ? -dividend : dividend;
+        FixedInt divisor_magnitude = divisor.is_negative() ? -divisor : divisor;
+        divide_unsigned(dividend_magnitude.limbs, divisor_magnitude.limbs, quotient.limbs, remainder.limbs);
+        if (quotient_negative) quotient = -quotient;
+        if (dividend_negative) remainder = -remainder;
+    }
+
+  public:
+    constexpr FixedInt() = default;
+
+    template<std::integral T>
+    constexpr FixedInt(T value) {
+        if constexpr (std::is_signed_v<T>) {
+            assign_extended(static_cast<uint128_t>(static_cast<int128_t>(value)), value < 0);
+        } else {
+            assign_extended(static_cast<uint128_t>(value), false);
+        }
+    }
+
+    constexpr FixedInt(int128_t value) {
+        assign_extended(static_cast<uint128_t>(value), value < 0);
+    }
+
+    constexpr FixedInt(uint128_t value) {
+        assign_extended(value, false);
+    }
+
+    // throws TooBigCastException or NegativeToUnsignedCastException if value is out of range
+    explicit FixedInt(const BigInteger& value) {
+        if (!Signed && value.is_negative()) throw NegativeToUnsignedCastException(value, typeid(FixedInt));
+        auto words = value.magnitude_words();
+        if (words.size() > LIMBS_COUNT) throw TooBigCastException(value, typeid(FixedInt));
+        for (size_t i = 0; i < words.size(); ++i) {
+            limbs[i] = words[i];
+        }
+        if ((limbs[LIMBS_COUNT - 1] & ~HIGHEST_LIMB_MASK) != 0) throw TooBigCastException(value, typeid(FixedInt));
+
+        // signed values keep their sign iff they are in [-2^(Bits - 1), 2^(Bits - 1))
+        if (value.is_negative()) *this = -*this;
+        if (is_negative() != value.is_negative()) throw TooBigCastException(value, typeid(FixedInt));
+    }
+
+    // exact value
+    operator BigInteger() const {
+        if (is_negative()) return BigInteger::from_magnitude_words((-*this).limbs, true);
+        return BigInteger::from_magnitude_words(limbs);
+    }
+
+    constexpr explicit operator bool() const {
+        return !is_zero();
+    }
+
+    // the lowest bits, as static_cast between built-in types
+    template<std::integral T>
+    constexpr explicit operator T() const {
+        return static_cast<T>(limbs[0]);
+    }
+
+    static constexpr FixedInt max() {
+        FixedInt result;
+        for (auto& limb : result.limbs) {
+            limb = ~0ull;
+        }
+        result.normalize();
+        if constexpr (Signed) result.limbs[LIMBS_COUNT - 1] &= HIGHEST_LIMB_MASK >> 1;
+        return result;
+    }
+
+    static constexpr FixedInt min() {
+        FixedInt result;
+        if constexpr (Signed) result.limbs[(Bits - 1) / LIMB_BITS] = 1ull << ((Bits - 1) % LIMB_BITS);
+        return result;
+    }
+
+    constexpr const limbs_t& get_limbs() const {
+        return limbs;
+    }
+
+    constexpr bool is_zero() const {
+        return significant_limbs(limbs) == 0;
+    }
+
+    constexpr bool is_negative() const {
+        if constexpr (Signed) {
+            return (limbs[(Bits - 1) / LIMB_BITS] >> ((Bits - 1) % LIMB_BITS)) & 1;
+        } else {
+            return false;
+        }
+    }
+
+    constexpr FixedInt& operator+=(const FixedInt& other) {
+        unsigned long long carry = 0;
+        for (size_t i = 0; i < LIMBS_COUNT; ++i) {
+            uint128_t sum = static_cast<uint128_t>(limbs[i]) + other.limbs[i] + carry;
+            limbs[i] = static_cast<unsigned long long>(sum);
+            carry = static_cast<unsigned long long>(sum >> LIMB_BITS);
+        }
+        normalize();
+        return *this;
+    }
+
+    constexpr FixedInt& operator-=(const FixedInt& other) {
+        unsigned long long borrow = 0;
+        for (size_t i = 0; i < LIMBS_COUNT; ++i) {
+            unsigned long long current = limbs[i];
+            limbs[i] = current - other.limbs[i] - borrow;
+            borrow = current < other.limbs[i] || current - other.limbs[i] < borrow;
+        }
+        normalize();
+        return *this;
+    }
+
+    // the product modulo 2^Bits is the same for signed and unsigned values
+    constexpr FixedInt& operator*=(const FixedInt& other) {
+        limbs_t result{};
+        for (size_t i = 0; i < LIMBS_COUNT; ++i) {
+            unsigned long long carry = 0;
+            for (size_t j = 0; i + j < LIMBS_COUNT; ++j) {
+                uint128_t current = static_cast<uint128_t>(limbs[i]) * other.limbs[j] + result[i + j] + carry;
+                result[i + j] = static_cast<unsigned long long>(current);
+                carry = static_cast<unsigned long long>(current >> LIMB_BITS);
+            }
+        }
+        limbs = result;
+        normalize();
+        return *this;
+    }
+
+    constexpr FixedInt& operator/=(const FixedInt& other) {
+        FixedInt remainder;
+        divmod(*this, other, *this, remainder);
+        return *this;
+    }
+
+    constexpr FixedInt& operator%=(const FixedInt& other) {
+        FixedInt quotient;
+        divmod(*this, other, quotient, *this);
+        return *this;
+    }
+
+    constexpr FixedInt& operator&=(const FixedInt& other) {
+        for (size_t i = 0; i < LIMBS_COUNT; ++i) {
+            limbs[i] &= other.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr FixedInt& operator|=(const FixedInt& other) {
+        for (size_t i = 0; i < LIMBS_COUNT; ++i) {
+            limbs[i] |= other.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr FixedInt& operator^=(const FixedInt& other) {
+        for (size_t i = 0; i < LIMBS_COUNT; ++i) {
+            limbs[i] ^= other.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr FixedInt operator~() const {
+        FixedInt result = *this;
+        for (auto& limb : result.limbs) {
+            limb = ~limb;
+        }
+        result.normalize();
+        return result;
+    }
+
+    constexpr FixedInt operator-() const {
+        FixedInt result;
+        result -= *this;
+        return result;
+    }
+
+    constexpr FixedInt& operator++() {
+        return *this += FixedInt(1);
+    }
+
+    constexpr FixedInt& operator--() {
+        return *this -= FixedInt(1);
+    }
+
+    friend constexpr FixedInt operator+(FixedInt left, const FixedInt& right) {
+        return left += right;
+    }
+
+    friend constexpr FixedInt operator-(FixedInt left, const FixedInt& right) {
+        return left -= right;
+    }
+
+    friend constexpr FixedInt operator*(FixedInt left, const FixedInt& right) {
+        return left *= right;
+    }
+
+    friend constexpr FixedInt operator/(FixedInt left, const FixedInt& right) {
+        return left /= right;
+    }
+
+    friend constexpr FixedInt operator%(FixedInt left, const FixedInt& right) {
+        return left %= right;
+    }
+
+    friend constexpr FixedInt operator&(FixedInt left, const FixedInt& right) {
+        return left &= right;
+    }
+
+    friend constexpr FixedInt operator|(FixedInt left, const FixedInt& right) {
+        return left |= right;
+    }
+
+    friend constexpr FixedInt operator^(FixedInt left, const FixedInt& right) {
+        return left ^= right;
+    }
+
+    friend constexpr bool operator==(const FixedInt& left, const FixedInt& right) {
+        return left.limbs == right.limbs;
+    }
+
+    friend constexpr strong_ordering operator<=>(const FixedInt& left, const FixedInt& right) {
+        if (left.is_negative() != right.is_negative()) {
+            return left.is_negative() ? strong_ordering::less : strong_ordering::greater;
+        }
+        // two's complement keeps the order of values of the same sign
+        return compare_limbs(left.limbs, right.limbs) <=> 0;
+    }
+
+    string toString() const {
+        return BigInteger(*this).toString();
+    }
+
+    friend std::ostream& operator<<(std::ostream& output, const FixedInt& value) {
+        return output << BigInteger(value);
+    }
+};
+
+using Int128 = FixedInt<128>;
+using UInt128 = FixedInt<128, false>;
+using Int256 = FixedInt<256>;
+using UInt256 = FixedInt<256, false>;
+using Int512 = FixedInt<512>;
+using UInt512 = FixedInt<512, false>;
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "bigint_test_helper.h"
+#include "fixedint.h"
+
+// value modulo 2^Bits in the range of FixedInt<Bits, Signed>
+template<size_t Bits, bool Signed>
+BigInteger wrap_to_fixed(const BigInteger& value) {
+    BigInteger modulus = BigInteger::power(2, Bits);
+    BigInteger result = value % modulus;
+    if (result.is_negative()) result += modulus;
+    if (Signed && result >= modulus / 2) result -= modulus;
+    return result;
+}
+
+// limbs that are likely to hit corner cases of carries and quotient estimations
+unsigned long long random_limb() {
+    switch (test_random() % 5) {
+        case 0: return 0;
+        case 1: return 1;
+        case 2: return ~0ull;
+        case 3: return 1ull << 63;
+        default: return (static_cast<unsigned long long>(test_random()) << 32) ^ test_random();
+    }
+}
+
+template<size_t Bits, bool Signed>
+FixedInt<Bits, Signed> random_fixed(size_t limbs_count) {
+    vector<unsigned long long> words(limbs_count);
+    for (auto& word : words) {
+        word = random_limb();
+    }
+    return FixedInt<Bits, Signed>(wrap_to_fixed<Bits, Signed>(BigInteger::from_magnitude_words(words, test_random() % 2)));
+}
+
+template<size_t Bits, bool Signed>
+void check_fixed_arithmetics() {
+    using Fixed = FixedInt<Bits, Signed>;
+    for (int i = 0; i < 10 * RANDOM_TRIES_COUNT; ++i) {
+        Fixed left = random_fixed<Bits, Signed>(1 + test_random() % Fixed::LIMBS_COUNT);
+        Fixed right = random_fixed<Bits, Signed>(1 + test_random() % Fixed::LIMBS_COUNT);
+        BigInteger big_left = left;
+        BigInteger big_right = right;
+        ASSERT_EQ((wrap_to_fixed<Bits, Signed>(big_left + big_right)), BigInteger(left + right));
+        ASSERT_EQ((wrap_to_fixed<Bits, Signed>(big_left - big_right)), BigInteger(left - right));
+        ASSERT_EQ((wrap_to_fixed<Bits, Signed>(big_left * big_right)), BigInteger(left * right));
+        ASSERT_EQ(big_left <=> big_right, left <=> right);
+        if (right.is_zero()) continue;
+        ASSERT_EQ((wrap_to_fixed<Bits, Signed>(big_left / big_right)), BigInteger(left / right)) << big_left << " " << big_right;
+        ASSERT_EQ(big_left % big_right, BigInteger(left % right)) << big_left << " " << big_right;
+    }
+}
+
+TEST(FixedIntTests, Arithmetics) {
+    check_fixed_arithmetics<256, true>();
+    check_fixed_arithmetics<256, false>();
+    check_fixed_arithmetics<512, false>();
+    check_fixed_arithmetics<100, true>();
+    check_fixed_arithmetics<65, false>();
+    check_fixed_arithmetics<7, true>();
+}
+
+TEST(FixedIntTests, AgreedWithBuiltIn) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        unsigned long long left = random_limb();
+        unsigned long long right = random_limb() | 1;
+        using Unsigned = FixedInt<64, false>;
+        ASSERT_EQ(left + right, static_cast<unsigned long long>(Unsigned(left) + Unsigned(right)));
+        ASSERT_EQ(left * right, static_cast<unsigned long long>(Unsigned(left) * Unsigned(right)));
+        ASSERT_EQ(left / right, static_cast<unsigned long long>(Unsigned(left) / Unsigned(right)));
+        ASSERT_EQ(~left, static_cast<unsigned long long>(~Unsigned(left)));
+
+        auto signed_left = static_cast<long long>(left);
+        auto signed_right = static_cast<long long>(right);
+        if (signed_right == -1) continue;
+        using Signed = FixedInt<64>;
+        ASSERT_EQ(signed_left / signed_right, static_cast<long long>(Signed(signed_left) / Signed(signed_right)));
+        ASSERT_EQ(signed_left % signed_right, static_cast<long long>(Signed(signed_left) % Signed(signed_right)));
+        ASSERT_EQ(signed_left < signed_right, Signed(signed_left) < Signed(signed_right));
+    }
+}
+
+TEST(FixedIntTests, Int128) {
+    int128_t value = static_cast<int128_t>(-1791791791791791791ll) * 1'000'000'007;
+    ASSERT_EQ(BigInteger(value), BigInteger(Int128(value)));
+    ASSERT_EQ(BigInteger(value / 57), BigInteger(Int128(value) / 57));
+    ASSERT_EQ(BigInteger(value % 57), BigInteger(Int128(value) % 57));
+}
+
+TEST(FixedIntTests, Limits) {
+    ASSERT_EQ(BigInteger::power(2, 255) - 1, BigInteger(Int256::max()));
+    ASSERT_EQ(-BigInteger::power(2, 255), BigInteger(Int256::min()));
+    ASSERT_EQ(BigInteger::power(2, 256) - 1, BigInteger(UInt256::max()));
+    ASSERT_EQ(0, BigInteger(UInt256::min()));
+    ASSERT_EQ(Int256::min(), Int256::max() + 1);
+    ASSERT_EQ(UInt256(0), UInt256::max() + 1);
+    ASSERT_EQ(Int256::min(), -Int256::min());
+    ASSERT_EQ(63, BigInteger(FixedInt<7>::max()));
+    ASSERT_EQ(-1, BigInteger(FixedInt<7>(127)));
+}
+
+TEST(FixedIntTests, FromBigInteger) {
+    for (size_t size : {1, 20, 50, 76}) {
+        BigInteger value = random_bigint(size);
+        ASSERT_EQ(value, BigInteger(Int256(value)));
+        ASSERT_EQ(-value, BigInteger(Int256(-value)));
+        ASSERT_EQ(value, BigInteger(UInt256(value)));
+    }
+    ASSERT_EQ(Int256::min(), Int256(-BigInteger::power(2, 255)));
+    ASSERT_THROW(Int256(BigInteger::power(2, 255)), TooBigCastException);
+    ASSERT_THROW(Int256(-BigInteger::power(2, 255) - 1), TooBigCastException);
+    ASSERT_THROW(UInt256(BigInteger::power(2, 256)), TooBigCastException);
+    ASSERT_THROW(UInt256(BigInteger(-1)), NegativeToUnsignedCastException);
+    ASSERT_THROW(FixedInt<7>(BigInteger(64)), TooBigCastException);
+    ASSERT_EQ(-64, BigInteger(FixedInt<7>(BigInteger(-64))));
+}
+
+TEST(FixedIntTests, Bitwise) {
+    UInt256 a = UInt256::max() - 5;
+    UInt256 b = 12;
+    ASSERT_EQ(8, BigInteger(a & b));
+    ASSERT_EQ(BigInteger(a) | BigInteger(b), BigInteger(a | b));
+    ASSERT_EQ(BigInteger(a) ^ BigInteger(b), BigInteger(a ^ b));
+    Int256 c = -12;
+    ASSERT_EQ(-12 & 10, BigInteger(c & Int256(10)));
+    ASSERT_EQ(11, BigInteger(~c));
+}
+
+TEST(FixedIntTests, DivisionByZero) {
+    ASSERT_THROW(Int256(5) / Int256(0), DivisionByZeroException);
+    ASSERT_THROW(UInt512(5) % UInt512(0), DivisionByZeroException);
+}
+
+TEST(FixedIntTests, ConstantExpressions) {
+    constexpr UInt256 a = UInt256(1'000'000'007) * UInt256(998'244'353) * UInt256::max();
+    constexpr UInt256 b = a / UInt256(1'000'000'007);
+    static_assert(b % UInt256(998'244'353) != UInt256(0));
+    static_assert(Int512(-7) / Int512(2) == Int512(-3));
+    static_assert(Int512(-7) % Int512(2) == Int512(-1));
+    static_assert(Int256::min() < Int256(-1));
+    BigInteger expected = wrap_to_fixed<256, false>(BigInteger(998'244'353) * -1'000'000'007) / 1'000'000'007;
+    ASSERT_EQ(expected, BigInteger(b));
+}
+
+TEST(FixedIntTests, Interoperability) {
+    Int256 a = 57;
+    BigInteger big = a + BigInteger("1000000000000000000000000000000");
+    ASSERT_EQ(BigInteger("1000000000000000000000000000057"), big);
+    Rational half = Rational(a) / Rational(114);
+    ASSERT_EQ("1/2", half.toString());
+    ASSERT_EQ("-57", (-a).toString());
+    std::stringstream output;
+    output << UInt512::max() / UInt512::max();
+    ASSERT_EQ("1", output.str());
+    ASSERT_TRUE(a == 57);
+    ASSERT_TRUE(static_cast<bool>(Int256(1) - 1 + UInt256::LIMBS_COUNT));
+    ASSERT_FALSE(static_cast<bool>(Int256(0)));
+}
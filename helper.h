@@ -11,25 +11,29 @@ using std::chrono::duration_cast;
 using std::chrono::milliseconds;
 using std::chrono::microseconds;
 
+// counts operator new[] calls, and also the scalar operator new calls (which std::vector and std::make_shared
+// go through) if count_scalar is set
 class OperatorNewCounter {
   private:
     int counter = 0;
     size_t total_size = 0;
+    bool count_scalar;
     static std::set<OperatorNewCounter*> instances;
     
-    void notify(size_t size) {
+    void notify(size_t size, bool scalar) {
+        if (scalar && !count_scalar) return;
         ++counter;
         total_size += size;
     }
 
   public:
-    OperatorNewCounter() {
+    explicit OperatorNewCounter(bool count_scalar = false) : count_scalar(count_scalar) {
         instances.insert(this);
     }
 
-    static void notify_all(size_t size) {
+    static void notify_all(size_t size, bool scalar = false) {
         for (auto item : instances) {
-            item->notify(size);
+            item->notify(size, scalar);
         }
     }
 
@@ -56,6 +60,13 @@ void* operator new[] (size_t size) {
     return p;
 }
 
+void* operator new(size_t size) {
+    OperatorNewCounter::notify_all(size, true);
+    void* p = malloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
 class Timer {
   private:
     steady_clock::time_point begin;
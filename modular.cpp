@@ -0,0 +1,310 @@
+#include <algorithm>
+
+#include "modular.h"
+#include "exceptions.h"
+
+// value mod modulus in [0, modulus) for any integer value
+static BigInteger reduce_by_division(const BigInteger& value, const BigInteger& modulus) {
+    BigInteger result = value % modulus;
+    if (result.is_negative()) result += modulus;
+    return result;
+}
+
+static void check_exponent(const BigInteger& exponent) {
+    if (exponent.is_negative()) throw InvalidArgumentException(exponent.toString(), "a non-negative exponent");
+}
+
+vector<bool> binary_digits(const BigInteger& value) {
+    vector<bool> result;
+    for (auto word : value.magnitude_words()) {
+        for (size_t bit = 0; bit < 64; ++bit) {
+            result.push_back((word >> bit) & 1);
+        }
+    }
+    while (!result.empty() && !result.back()) result.pop_back();
+    return result;
+}
+
+static size_t sliding_window_width(size_t bits_count) {
+    if (bits_count > 671) return 6;
+    if (bits_count > 239) return 5;
+    if (bits_count > 79) return 4;
+    if (bits_count > 23) return 3;
+    return 1;
+}
+
+// Context works with its own representation of numbers (residues), one is the residue of 1.
+// Left-to-right sliding window: zero bits are squarings,
+// windows ending with a one bit are multiplications by precomputed odd powers
+template<typename Context>
+static BigInteger sliding_window_power(const Context& context, const BigInteger& base, const BigInteger& one, const BigInteger& exponent) {
+    vector<bool> bits = binary_digits(exponent);
+    size_t width = sliding_window_width(bits.size());
+
+    // odd_powers[i] = base^(2i + 1)
+    vector<BigInteger> odd_powers(1, base);
+    BigInteger base_square = context.sqrmod(base);
+    for (size_t i = 1; i < (1u << (width - 1)); ++i) {
+        odd_powers.push_back(context.mulmod(odd_powers.back(), base_square));
+    }
+
+    BigInteger result = one;
+    for (size_t position = bits.size(); position > 0; ) {
+        if (!bits[position - 1]) {
+            result = context.sqrmod(result);
+            --position;
+            continue;
+        }
+
+        // the longest window not longer than width which ends with a one bit
+        size_t length = std::min(width, position);
+        while (!bits[position - length]) --length;
+
+        size_t window = 0;
+        for (size_t i = 0; i < length; ++i) {
+            result = context.sqrmod(result);
+            window = window * 2 + bits[position - 1 - i];
+        }
+        result = context.mulmod(result, odd_powers[window / 2]);
+        position -= length;
+    }
+    return result;
+}
+
+const size_t FIXED_WINDOW_WIDTH = 4;
+
+// Every window of FIXED_WINDOW_WIDTH bits costs the same squarings and one multiplication
+// (by the residue of one for zero windows), so the sequence of operations depends
+// only on the length of exponent, not on its bits
+template<typename Context>
+static BigInteger fixed_window_power(const Context& context, const BigInteger& base, const BigInteger& one, const BigInteger& exponent) {
+    vector<bool> bits = binary_digits(exponent);
+    bits.resize((bits.size() + FIXED_WINDOW_WIDTH - 1) / FIXED_WINDOW_WIDTH * FIXED_WINDOW_WIDTH, false);
+
+    vector<BigInteger> powers(1, one);
+    for (size_t i = 1; i < (1u << FIXED_WINDOW_WIDTH); ++i) {
+        powers.push_back(context.mulmod(powers.back(), base));
+    }
+
+    BigInteger result = one;
+    for (size_t position = bits.size(); position > 0; position -= FIXED_WINDOW_WIDTH) {
+        size_t window = 0;
+        for (size_t i = 0; i < FIXED_WINDOW_WIDTH; ++i) {
+            result = context.sqrmod(result);
+            window = window * 2 + bits[position - 1 - i];
+        }
+        result = context.mulmod(result, powers[window]);
+    }
+    return result;
+}
+
+const size_t MULTI_WINDOW_WIDTH = 2;
+
+// first_base^first_exponent * second_base^second_exponent with shared squarings:
+// both exponents are scanned by windows simultaneously using a table of all the products
+// first_base^i * second_base^j for window values i and j
+template<typename Context>
+static BigInteger multi_power(const Context& context, const BigInteger& first_base, const BigInteger& first_exponent,
+        const BigInteger& second_base, const BigInteger& second_exponent, const BigInteger& one) {
+    vector<bool> first_bits = binary_digits(first_exponent);
+    vector<bool> second_bits = binary_digits(second_exponent);
+    size_t length = std::max(first_bits.size(), second_bits.size());
+    length = (length + MULTI_WINDOW_WIDTH - 1) / MULTI_WINDOW_WIDTH * MULTI_WINDOW_WIDTH;
+    first_bits.resize(length, false);
+    second_bits.resize(length, false);
+
+    const size_t table_side = 1u << MULTI_WINDOW_WIDTH;
+    vector<BigInteger> table(table_side * table_side, one);
+    for (size_t i = 0; i < table_side; ++i) {
+        if (i > 0) table[i * table_side] = context.mulmod(table[(i - 1) * table_side], first_base);
+        for (size_t j = 1; j < table_side; ++j) {
+            table[i * table_side + j] = context.mulmod(table[i * table_side + j - 1], second_base);
+        }
+    }
+
+    BigInteger result = one;
+    for (size_t position = length; position > 0; position -= MULTI_WINDOW_WIDTH) {
+        size_t first_window = 0;
+        size_t second_window = 0;
+        for (size_t i = 0; i < MULTI_WINDOW_WIDTH; ++i) {
+            result = context.sqrmod(result);
+            first_window = first_window * 2 + first_bits[position - 1 - i];
+            second_window = second_window * 2 + second_bits[position - 1 - i];
+        }
+        if (first_window != 0 || second_window != 0) {
+            result = context.mulmod(result, table[first_window * table_side + second_window]);
+        }
+    }
+    return result;
+}
+
+static bool is_montgomery_friendly(const BigInteger& modulus) {
+    return modulus.digit(0) % 2 != 0 && modulus.digit(0) != 5;
+}
+
+BigInteger powmod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus) {
+    if (modulus > 0 && is_montgomery_friendly(modulus)) return MontgomeryContext(modulus).powmod(base, exponent);
+    return ModContext(modulus).powmod(base, exponent);
+}
+
+BigInteger powmod_fixed_window(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus) {
+    if (modulus > 0 && is_montgomery_friendly(modulus)) return MontgomeryContext(modulus).powmod_fixed_window(base, exponent);
+    return ModContext(modulus).powmod_fixed_window(base, exponent);
+}
+
+BigInteger multi_powmod(const BigInteger& first_base, const BigInteger& first_exponent,
+        const BigInteger& second_base, const BigInteger& second_exponent, const BigInteger& modulus) {
+    if (modulus > 0 && is_montgomery_friendly(modulus)) {
+        return MontgomeryContext(modulus).multi_powmod(first_base, first_exponent, second_base, second_exponent);
+    }
+    return ModContext(modulus).multi_powmod(first_base, first_exponent, second_base, second_exponent);
+}
+
+ModContext::ModContext(const BigInteger& modulus) : modulus(modulus), digits_count(modulus.size()) {
+    if (modulus <= 0) throw InvalidArgumentException(modulus.toString(), "a positive modulus");
+    reciprocal = 1;
+    reciprocal.shift(2 * digits_count);
+    reciprocal /= modulus;
+}
+
+const BigInteger& ModContext::get_modulus() const {
+    return modulus;
+}
+
+BigInteger ModContext::reduce(const BigInteger& value) const {
+    if (value.is_negative() || value.size() > 2 * digits_count) return reduce_by_division(value, modulus);
+
+    // estimation of value / modulus, which is less than the real quotient by at most 2
+    BigInteger quotient = value;
+    quotient.shift(-static_cast<int>(digits_count - 1));
+    quotient *= reciprocal;
+    quotient.shift(-static_cast<int>(digits_count + 1));
+
+    BigInteger result = value;
+    BigInteger::submul(result, quotient, modulus);
+    while (result >= modulus) result -= modulus;
+    return result;
+}
+
+BigInteger ModContext::mulmod(const BigInteger& left, const BigInteger& right) const {
+    return reduce(left * right);
+}
+
+BigInteger ModContext::sqrmod(const BigInteger& value) const {
+    return reduce(value * value);
+}
+
+BigInteger ModContext::addmod(const BigInteger& left, const BigInteger& right) const {
+    BigInteger result = left + right;
+    if (result >= modulus) result -= modulus;
+    return result;
+}
+
+BigInteger ModContext::submod(const BigInteger& left, const BigInteger& right) const {
+    BigInteger result = left - right;
+    if (result.is_negative()) result += modulus;
+    return result;
+}
+
+BigInteger ModContext::powmod(const BigInteger& base, const BigInteger& exponent) const {
+    check_exponent(exponent);
+    return sliding_window_power(*this, reduce(base), reduce(1), exponent);
+}
+
+BigInteger ModContext::powmod_fixed_window(const BigInteger& base, const BigInteger& exponent) const {
+    check_exponent(exponent);
+    return fixed_window_power(*this, reduce(base), reduce(1), exponent);
+}
+
+BigInteger ModContext::multi_powmod(const BigInteger& first_base, const BigInteger& first_exponent,
+        const BigInteger& second_base, const BigInteger& second_exponent) const {
+    check_exponent(first_exponent);
+    check_exponent(second_exponent);
+    return multi_power(*this, reduce(first_base), first_exponent, reduce(second_base), second_exponent, reduce(1));
+}
+
+MontgomeryContext::MontgomeryContext(const BigInteger& modulus) : modulus(modulus), digits_count(modulus.size()) {
+    if (modulus <= 0) throw InvalidArgumentException(modulus.toString(), "a positive modulus");
+    if (modulus.digit(0) % 2 == 0 || modulus.digit(0) == 5) {
+        throw InvalidArgumentException(modulus.toString(), "a modulus coprime with 10");
+    }
+
+    BigInteger r = 1;
+    r.shift(digits_count);
+    inverse = r - BigInteger::inverse_modulo_base_power(modulus, digits_count);
+
+    r_squared = 1;
+    r_squared.shift(2 * digits_count);
+    r_squared %= modulus;
+}
+
+const BigInteger& MontgomeryContext::get_modulus() const {
+    return modulus;
+}
+
+BigInteger MontgomeryContext::redc(const BigInteger& value) const {
+    // factor makes value + factor * modulus divisible by R
+    BigInteger factor = value;
+    factor.truncate(digits_count);
+    factor *= inverse;
+    factor.truncate(digits_count);
+
+    BigInteger result = value;
+    BigInteger::addmul(result, factor, modulus);
+    result.shift(-static_cast<int>(digits_count));
+    if (result >= modulus) result -= modulus;
+    return result;
+}
+
+BigInteger MontgomeryContext::to_montgomery(const BigInteger& value) const {
+    return redc(value * r_squared);
+}
+
+BigInteger MontgomeryContext::from_montgomery(const BigInteger& value) const {
+    return redc(value);
+}
+
+BigInteger MontgomeryContext::one() const {
+    return redc(r_squared);
+}
+
+BigInteger MontgomeryContext::mulmod(const BigInteger& left, const BigInteger& right) const {
+    return redc(left * right);
+}
+
+BigInteger MontgomeryContext::sqrmod(const BigInteger& value) const {
+    return redc(value * value);
+}
+
+BigInteger MontgomeryContext::addmod(const BigInteger& left, const BigInteger& right) const {
+    BigInteger result = left + right;
+    if (result >= modulus) result -= modulus;
+    return result;
+}
+
+BigInteger MontgomeryContext::submod(const BigInteger& left, const BigInteger& right) const {
+    BigInteger result = left - right;
+    if (result.is_negative()) result += modulus;
+    return result;
+}
+
+BigInteger MontgomeryContext::powmod(const BigInteger& base, const BigInteger& exponent) const {
+    check_exponent(exponent);
+    BigInteger base_residue = to_montgomery(reduce_by_division(base, modulus));
+    return from_montgomery(sliding_window_power(*this, base_residue, one(), exponent));
+}
+
+BigInteger MontgomeryContext::powmod_fixed_window(const BigInteger& base, const BigInteger& exponent) const {
+    check_exponent(exponent);
+    BigInteger base_residue = to_montgomery(reduce_by_division(base, modulus));
+    return from_montgomery(fixed_window_power(*this, base_residue, one(), exponent));
+}
+
+BigInteger MontgomeryContext::multi_powmod(const BigInteger& first_base, const BigInteger& first_exponent,
+        const BigInteger& second_base, const BigInteger& second_exponent) const {
+    check_exponent(first_exponent);
+    check_exponent(second_exponent);
+    BigInteger first_residue = to_montgomery(reduce_by_division(first_base, modulus));
+    BigInteger second_residue = to_montgomery(reduce_by_division(second_base, modulus));
+    return from_montgomery(multi_power(*this, first_residue, first_exponent, second_residue, second_exponent, one()));
+}
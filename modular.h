@@ -0,0 +1,99 @@
+#pragma once
+
+#include "biginteger.h"
+
+// Arithmetic modulo a fixed modulus without general divisions
+// (except for the precomputation and reduction of unusual inputs).
+// All the values passed to mulmod, sqrmod, addmod and submod must be in [0, modulus).
+
+// binary digits of non-negative value, the lowest first (no leading zeroes, empty for 0)
+vector<bool> binary_digits(const BigInteger& value);
+
+// Barrett reduction, works with any positive modulus
+class ModContext {
+  private:
+    BigInteger modulus;
+    size_t digits_count;
+    // BASE^(2 * digits_count) / modulus
+    BigInteger reciprocal;
+
+  public:
+    explicit ModContext(const BigInteger& modulus);
+
+    const BigInteger& get_modulus() const;
+
+    // value modulo modulus in [0, modulus), fast for values in [0, BASE^(2 * modulus.size()))
+    BigInteger reduce(const BigInteger& value) const;
+
+    BigInteger mulmod(const BigInteger& left, const BigInteger& right) const;
+
+    BigInteger sqrmod(const BigInteger& value) const;
+
+    BigInteger addmod(const BigInteger& left, const BigInteger& right) const;
+
+    BigInteger submod(const BigInteger& left, const BigInteger& right) const;
+
+    // base may be any integer, exponent must be non-negative; sliding window exponentiation
+    BigInteger powmod(const BigInteger& base, const BigInteger& exponent) const;
+
+    // the same sequence of operations for all exponents of the same length
+    BigInteger powmod_fixed_window(const BigInteger& base, const BigInteger& exponent) const;
+
+    // first_base^first_exponent * second_base^second_exponent sharing the squarings
+    BigInteger multi_powmod(const BigInteger& first_base, const BigInteger& first_exponent,
+        const BigInteger& second_base, const BigInteger& second_exponent) const;
+};
+
+// Montgomery reduction with R = BASE^modulus.size(), modulus must be coprime with BASE.
+// mulmod, sqrmod, addmod and submod work with numbers in Montgomery form (value * R mod modulus)
+class MontgomeryContext {
+  private:
+    BigInteger modulus;
+    size_t digits_count;
+    // -modulus^(-1) mod R
+    BigInteger inverse;
+    // R^2 mod modulus
+    BigInteger r_squared;
+
+    // value * R^(-1) mod modulus for value in [0, modulus * R)
+    BigInteger redc(const BigInteger& value) const;
+
+  public:
+    explicit MontgomeryContext(const BigInteger& modulus);
+
+    const BigInteger& get_modulus() const;
+
+    // converts value from [0, modulus) to Montgomery form
+    BigInteger to_montgomery(const BigInteger& value) const;
+
+    BigInteger from_montgomery(const BigInteger& value) const;
+
+    // Montgomery form of 1
+    BigInteger one() const;
+
+    BigInteger mulmod(const BigInteger& left, const BigInteger& right) const;
+
+    BigInteger sqrmod(const BigInteger& value) const;
+
+    BigInteger addmod(const BigInteger& left, const BigInteger& right) const;
+
+    BigInteger submod(const BigInteger& left, const BigInteger& right) const;
+
+    // powmod, powmod_fixed_window and multi_powmod work with usual numbers (not Montgomery form)
+    // and are the same as in ModContext
+    BigInteger powmod(const BigInteger& base, const BigInteger& exponent) const;
+
+    BigInteger powmod_fixed_window(const BigInteger& base, const BigInteger& exponent) const;
+
+    BigInteger multi_powmod(const BigInteger& first_base, const BigInteger& first_exponent,
+        const BigInteger& second_base, const BigInteger& second_exponent) const;
+};
+
+// base^exponent mod modulus in [0, modulus), uses Montgomery reduction
+// when modulus is coprime with BASE and Barrett reduction otherwise
+BigInteger powmod(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus);
+
+BigInteger powmod_fixed_window(const BigInteger& base, const BigInteger& exponent, const BigInteger& modulus);
+
+BigInteger multi_powmod(const BigInteger& first_base, const BigInteger& first_exponent,
+    const BigInteger& second_base, const BigInteger& second_exponent, const BigInteger& modulus);
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "bigint_test_helper.h"
+#include "modular.h"
+
+const BigInteger MERSENNE_127 = BigInteger("170141183460469231731687303715884105727");
+
+BigInteger naive_powmod(BigInteger base, long long exponent, const BigInteger& modulus) {
+    BigInteger result = 1;
+    for (long long i = 0; i < exponent; ++i) {
+        result = result * base % modulus;
+    }
+    return result;
+}
+
+TEST(BiMethodsTests, InverseModuloBasePower) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger value = random_bigint(50) * 10 + 7;
+        BigInteger inverse = BigInteger::inverse_modulo_base_power(value, 40);
+        BigInteger product = value * inverse;
+        product.truncate(40);
+        ASSERT_EQ(1, product);
+        ASSERT_LE(inverse.size(), 40);
+    }
+}
+
+TEST(BiMethodsTests, InverseModuloBasePowerNegative) {
+    BigInteger inverse = BigInteger::inverse_modulo_base_power(-3, 5);
+    ASSERT_EQ(33333, inverse);
+}
+
+TEST(BiMethodsTests, InverseModuloBasePowerNotCoprime) {
+    ASSERT_THROW(BigInteger::inverse_modulo_base_power(15, 5), InvalidArgumentException);
+}
+
+TEST(BiMethodsTests, Truncate) {
+    BigInteger a = -1791791791;
+    a.truncate(4);
+    ASSERT_EQ(-1791, a);
+    a.truncate(2);
+    ASSERT_EQ(-91, a);
+    BigInteger b = 1000179;
+    b.truncate(3);
+    ASSERT_EQ(179, b);
+    b.truncate(0);
+    ASSERT_EQ(0, b);
+    ASSERT_FALSE(b.is_negative());
+}
+
+TEST(ModularTests, BarrettMulmod) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger modulus = random_bigint(40) + 1;
+        ModContext context(modulus);
+        BigInteger a = random_bigint(40) % modulus;
+        BigInteger b = random_bigint(40) % modulus;
+        ASSERT_EQ(a * b % modulus, context.mulmod(a, b));
+        ASSERT_EQ(a * a % modulus, context.sqrmod(a));
+        ASSERT_EQ((a + b) % modulus, context.addmod(a, b));
+        ASSERT_EQ(((a - b) % modulus + modulus) % modulus, context.submod(a, b));
+    }
+}
+
+TEST(ModularTests, BarrettReduce) {
+    ModContext context(1000);
+    ASSERT_EQ(179, context.reduce(1179));
+    ASSERT_EQ(821, context.reduce(-179));
+    ASSERT_EQ(0, context.reduce(BigInteger("1000000000000000000000")));
+}
+
+TEST(ModularTests, BarrettPowmod) {
+    ModContext context(1'000'000'000'000ll);
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger base = random_bigint(15);
+        long long exponent = random_value() % 100;
+        ASSERT_EQ(naive_powmod(base, exponent, context.get_modulus()), context.powmod(base, exponent));
+    }
+}
+
+TEST(ModularTests, BarrettPowmodNegativeBase) {
+    ModContext context(7);
+    ASSERT_EQ(1, context.powmod(-1, 2));
+    ASSERT_EQ(6, context.powmod(-1, 3));
+}
+
+TEST(ModularTests, InvalidModulus) {
+    ASSERT_THROW(ModContext context(0), InvalidArgumentException);
+    ASSERT_THROW(MontgomeryContext context(-7), InvalidArgumentException);
+    ASSERT_THROW(MontgomeryContext context(1000), InvalidArgumentException);
+    ASSERT_THROW(MontgomeryContext context(25), InvalidArgumentException);
+}
+
+TEST(ModularTests, NegativeExponent) {
+    ModContext context(7);
+    ASSERT_THROW(context.powmod(2, -1), InvalidArgumentException);
+}
+
+TEST(ModularTests, MontgomeryRoundTrip) {
+    MontgomeryContext context(MERSENNE_127);
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger a = random_bigint(30);
+        ASSERT_EQ(a, context.from_montgomery(context.to_montgomery(a)));
+    }
+    ASSERT_EQ(1, context.from_montgomery(context.one()));
+}
+
+TEST(ModularTests, MontgomeryMulmod) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger modulus = random_bigint(40) * 10 + 3;
+        MontgomeryContext context(modulus);
+        BigInteger a = random_bigint(40) % modulus;
+        BigInteger b = random_bigint(40) % modulus;
+        BigInteger a_residue = context.to_montgomery(a);
+        BigInteger b_residue = context.to_montgomery(b);
+        ASSERT_EQ(a * b % modulus, context.from_montgomery(context.mulmod(a_residue, b_residue)));
+        ASSERT_EQ(a * a % modulus, context.from_montgomery(context.sqrmod(a_residue)));
+        ASSERT_EQ((a + b) % modulus, context.from_montgomery(context.addmod(a_residue, b_residue)));
+        ASSERT_EQ(((a - b) % modulus + modulus) % modulus, context.from_montgomery(context.submod(a_residue, b_residue)));
+    }
+}
+
+TEST(ModularTests, MontgomeryPowmod) {
+    MontgomeryContext context(1'000'000'007);
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger base = random_bigint(15);
+        long long exponent = random_value() % 100;
+        ASSERT_EQ(naive_powmod(base, exponent, context.get_modulus()), context.powmod(base, exponent));
+    }
+}
+
+TEST(ModularTests, MontgomeryFermat) {
+    MontgomeryContext context(MERSENNE_127);
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger base = random_bigint(30) + 1;
+        ASSERT_EQ(1, context.powmod(base, MERSENNE_127 - 1));
+    }
+}
+
+TEST(ModularTests, PowmodAgreed) {
+    BigInteger modulus = random_bigint(60) * 10 + 9;
+    ModContext barrett(modulus);
+    MontgomeryContext montgomery(modulus);
+    BigInteger base = random_bigint(100);
+    BigInteger exponent = random_bigint(50);
+    ASSERT_EQ(barrett.powmod(base, exponent), montgomery.powmod(base, exponent));
+}
+
+TEST(ModularTests, ModulusOne) {
+    ModContext barrett(1);
+    MontgomeryContext montgomery(1);
+    ASSERT_EQ(0, barrett.powmod(179, 57));
+    ASSERT_EQ(0, montgomery.powmod(179, 57));
+    ASSERT_EQ(0, barrett.powmod(179, 0));
+}
+
+TEST(ModularTests, Powmod) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger base = random_bigint(20);
+        long long exponent = random_value() % 100;
+        BigInteger modulus = random_bigint(10) + 1;
+        ASSERT_EQ(BigInteger::power(base, exponent) % modulus, powmod(base, exponent, modulus));
+    }
+}
+
+TEST(ModularTests, PowmodEvenModulus) {
+    ASSERT_EQ(855220001, powmod(3, 1000, BigInteger::power(10, 9)));
+    ASSERT_EQ(0, powmod(2, 64, 1024));
+    ASSERT_EQ(1, powmod(-7, 0, 10));
+    ASSERT_EQ(3, powmod(-7, 1, 10));
+}
+
+TEST(ModularTests, PowmodLongExponent) {
+    // windows of every width are used for exponents of different lengths
+    BigInteger modulus = random_bigint(40) * 10 + 3;
+    BigInteger base = random_bigint(45);
+    for (size_t size : {1, 5, 10, 30, 100, 300}) {
+        BigInteger exponent = random_bigint(size);
+        BigInteger expected = powmod_fixed_window(base, exponent, modulus);
+        ASSERT_EQ(expected, powmod(base, exponent, modulus));
+        ASSERT_EQ(expected, ModContext(modulus).powmod(base, exponent));
+        ASSERT_EQ(expected, ModContext(modulus).powmod_fixed_window(base, exponent));
+    }
+}
+
+TEST(ModularTests, PowmodFixedWindow) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger base = random_bigint(15);
+        long long exponent = random_value() % 100;
+        BigInteger modulus = random_bigint(10) + 1;
+        ASSERT_EQ(naive_powmod(base, exponent, modulus), powmod_fixed_window(base, exponent, modulus));
+    }
+}
+
+TEST(ModularTests, MultiPowmod) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger modulus = random_bigint(30) + 1;
+        BigInteger first_base = random_bigint(30);
+        BigInteger second_base = random_bigint(30);
+        BigInteger first_exponent = random_bigint(1 + i);
+        BigInteger second_exponent = random_bigint(20 - i);
+        BigInteger expected = powmod(first_base, first_exponent, modulus) * powmod(second_base, second_exponent, modulus) % modulus;
+        ASSERT_EQ(expected, multi_powmod(first_base, first_exponent, second_base, second_exponent, modulus));
+    }
+}
+
+TEST(ModularTests, MultiPowmodZeroExponents) {
+    ASSERT_EQ(1, multi_powmod(5, 0, 7, 0, 11));
+    ASSERT_EQ(5, multi_powmod(5, 1, 7, 0, 11));
+    ASSERT_EQ(7, multi_powmod(5, 0, 7, 1, 11));
+    ASSERT_THROW(multi_powmod(5, -1, 7, 1, 11), InvalidArgumentException);
+}
@@ -0,0 +1,324 @@
+#include <array>
+#include <algorithm>
+#include <limits>
+
+#include "primes.h"
+#include "algorithms.h"
+#include "exceptions.h"
+#include "modular.h"
+
+vector<unsigned long long> primes_up_to(unsigned long long limit) {
+    vector<unsigned long long> result;
+    if (limit < 2) return result;
+    result.push_back(2);
+
+    // composite[i] is for the odd number 2i + 1
+    vector<bool> composite(limit / 2 + 1, false);
+    for (unsigned long long i = 1; 2 * i + 1 <= limit; ++i) {
+        if (composite[i]) continue;
+        unsigned long long prime = 2 * i + 1;
+        result.push_back(prime);
+        if (prime > limit / prime) continue;
+        for (unsigned long long multiple = prime * prime; multiple <= limit; multiple += 2 * prime) {
+            composite[multiple / 2] = true;
+        }
+    }
+    return result;
+}
+
+const size_t CHUNK_LENGTH = 9;
+
+// CHUNK_POWERS[i] = 10^i for chunks of i digits
+constexpr auto CHUNK_POWERS = [] {
+    std::array<unsigned long long, CHUNK_LENGTH + 1> powers{1};
+    for (size_t i = 1; i <= CHUNK_LENGTH; ++i) powers[i] = powers[i - 1] * 10;
+    return powers;
+}();
+const unsigned long long WORD_LIMIT = 1ull << 32;
+
+vector<unsigned long long> remainders_by_words(const BigInteger& value, const vector<unsigned long long>& moduli) {
+    // the value is read by chunks of 9 digits from the highest one; the remainders
+    // of one chunk do not depend on each other, so their divisions overlap in the pipeline
+    vector<unsigned long long> remainders(moduli.size(), 0);
+    size_t position = value.size();
+    size_t chunk_length = (position - 1) % CHUNK_LENGTH + 1;
+    unsigned long long chunk_base = CHUNK_POWERS[chunk_length];
+
+    while (position > 0) {
+        unsigned long long chunk = 0;
+        for (size_t i = 0; i < chunk_length; ++i) {
+            chunk = chunk * 10 + value.digit(position - 1 - i);
+        }
+        position -= chunk_length;
+
+        for (size_t i = 0; i < moduli.size(); ++i) {
+            remainders[i] = (remainders[i] * chunk_base + chunk) % moduli[i];
+        }
+        chunk_length = CHUNK_LENGTH;
+        chunk_base = CHUNK_POWERS[CHUNK_LENGTH];
+    }
+    return remainders;
+}
+
+// small primes packed into products below 2^32, so one remainder serves several primes
+struct SmallPrimes {
+    vector<unsigned long long> primes;
+    vector<unsigned long long> products;
+    // primes of products[i] are primes[group_begin[i]..group_begin[i + 1])
+    vector<size_t> group_begin;
+
+    SmallPrimes() : primes(primes_up_to(SMALL_PRIMES_LIMIT)) {
+        for (size_t i = 0; i < primes.size(); ++i) {
+            if (products.empty() || products.back() * primes[i] >= WORD_LIMIT) {
+                products.push_back(1);
+                group_begin.push_back(i);
+            }
+            products.back() *= primes[i];
+        }
+        group_begin.push_back(primes.size());
+    }
+
+    // value % primes[i] for every small prime
+    vector<unsigned long long> remainders(const BigInteger& value) const {
+        vector<unsigned long long> product_remainders = remainders_by_words(value, products);
+        vector<unsigned long long> result(primes.size());
+        for (size_t group = 0; group < products.size(); ++group) {
+            for (size_t i = group_begin[group]; i < group_begin[group + 1]; ++i) {
+                result[i] = product_remainders[group] % primes[i];
+            }
+        }
+        return result;
+    }
+};
+
+static const SmallPrimes& small_primes() {
+    static const SmallPrimes instance;
+    return instance;
+}
+
+const unsigned long long SMALL_PRIMES_SQUARE = SMALL_PRIMES_LIMIT * SMALL_PRIMES_LIMIT;
+
+// value = d * 2^s + 1 with odd d
+static size_t split_power_of_two(const BigInteger& value, BigInteger& d) {
+    d = value - 1;
+    size_t s = 0;
+    while (!d.is_zero() && d.digit(0) % 2 == 0) {
+        d /= 2;
+        ++s;
+    }
+    return s;
+}
+
+// x = base^d in the context representation, one and minus_one are the residues of 1 and -1
+template<typename Context>
+static bool strong_test(const Context& context, BigInteger x, const BigInteger& one, const BigInteger& minus_one, size_t s) {
+    if (x == one || x == minus_one) return true;
+    for (size_t r = 1; r < s; ++r) {
+        x = context.sqrmod(x);
+        if (x == minus_one) return true;
+        if (x == one) return false;
+    }
+    return false;
+}
+
+static bool is_coprime_with_base(const BigInteger& value) {
+    return value.digit(0) % 2 != 0 && value.digit(0) != 5;
+}
+
+bool is_strong_probable_prime(const BigInteger& value, const BigInteger& base) {
+    if (value <= 2 || value.digit(0) % 2 == 0) {
+        throw InvalidArgumentException(value.toString(), "an odd value greater than 2");
+    }
+    BigInteger d;
+    size_t s = split_power_of_two(value, d);
+
+    if (is_coprime_with_base(value)) {
+        MontgomeryContext context(value);
+        BigInteger x = context.to_montgomery(context.powmod(base, d));
+        return strong_test(context, x, context.one(), context.to_montgomery(value - 1), s);
+    }
+    ModContext context(value);
+    return strong_test(context, context.powmod(base, d), 1, value - 1, s);
+}
+
+// Jacobi symbol (a / n) for odd positive a and n
+static int jacobi(unsigned long long a, unsigned long long n) {
+    int result = 1;
+    a %= n;
+    while (a != 0) {
+        while (a % 2 == 0) {
+            a /= 2;
+            if (n % 8 == 3 || n % 8 == 5) result = -result;
+        }
+        std::swap(a, n);
+        if (a % 4 == 3 && n % 4 == 3) result = -result;
+        a %= n;
+    }
+    return n == 1 ? result : 0;
+}
+
+// Jacobi symbol (d / n) for odd d and odd positive n by the quadratic reciprocity
+static int jacobi(long long d, const BigInteger& n) {
+    int result = 1;
+    unsigned long long n_mod_4 = (n.digit(1) * 10 + n.digit(0)) % 4;
+    if (d < 0) {
+        d = -d;
+        if (n_mod_4 == 3) result = -result;
+    }
+    auto magnitude = static_cast<unsigned long long>(d);
+    if (magnitude % 4 == 3 && n_mod_4 == 3) result = -result;
+    unsigned long long n_mod_d = remainders_by_words(n, {magnitude})[0];
+    return result * jacobi(n_mod_d, magnitude);
+}
+
+// value / 2 modulo odd modulus for value in [0, modulus)
+static BigInteger half_modulo(BigInteger value, const BigInteger& modulus) {
+    if (value.digit(0) % 2 != 0) value += modulus;
+    return value /= 2;
+}
+
+const size_t SQUARE_CHECK_ATTEMPTS = 10;
+
+// strong Lucas test with Selfridge's parameters: the first D of 5, -7, 9, -11, ...
+// with (D / value) = -1, P = 1 and Q = (1 - D) / 4; value must be odd and coprime with 10
+static bool is_strong_lucas_probable_prime(const BigInteger& value) {
+    long long d = 5;
+    for (size_t attempt = 1; ; ++attempt) {
+        int symbol = jacobi(d, value);
+        if (symbol == -1) break;
+        if (symbol == 0 && value > (d < 0 ? -d : d)) return false;
+        // there is no suitable D for squares
+        if (attempt == SQUARE_CHECK_ATTEMPTS) {
+            BigInteger root = isqrt(value);
+            if (root * root == value) return false;
+        }
+        d = d > 0 ? -(d + 2) : -d + 2;
+    }
+    long long q = (1 - d) / 4;
+
+    MontgomeryContext context(value);
+    auto residue = [&](long long number) {
+        BigInteger result = number;
+        if (result.is_negative()) result += value;
+        return context.to_montgomery(result);
+    };
+    BigInteger d_residue = residue(d);
+    BigInteger q_residue = residue(q);
+
+    // value + 1 = k * 2^s with odd k (split_power_of_two splits its argument minus one)
+    BigInteger k;
+    size_t s = split_power_of_two(value + 2, k);
+    vector<bool> bits = binary_digits(k);
+
+    // u = U_j, v = V_j, q_power = Q^j starting from j = 1
+    BigInteger u = context.one();
+    BigInteger v = context.one();
+    BigInteger q_power = q_residue;
+    for (size_t position = bits.size() - 1; position > 0; --position) {
+        u = context.mulmod(u, v);
+        v = context.submod(context.sqrmod(v), context.addmod(q_power, q_power));
+        q_power = context.sqrmod(q_power);
+        if (bits[position - 1]) {
+            BigInteger next_u = half_modulo(context.addmod(u, v), value);
+            v = half_modulo(context.addmod(context.mulmod(d_residue, u), v), value);
+            u = std::move(next_u);
+            q_power = context.mulmod(q_power, q_residue);
+        }
+    }
+
+    if (u.is_zero() || v.is_zero()) return true;
+    for (size_t r = 1; r < s; ++r) {
+        v = context.submod(context.sqrmod(v), context.addmod(q_power, q_power));
+        if (v.is_zero()) return true;
+        q_power = context.sqrmod(q_power);
+    }
+    return false;
+}
+
+bool is_probable_prime(const BigInteger& value) {
+    if (value < 2) return false;
+
+    const auto& small = small_primes();
+    auto remainders = small.remainders(value);
+    for (size_t i = 0; i < small.primes.size(); ++i) {
+        if (remainders[i] == 0) return value == small.primes[i];
+    }
+    if (value < SMALL_PRIMES_SQUARE) return true;
+
+    return is_strong_probable_prime(value, 2) && is_strong_lucas_probable_prime(value);
+}
+
+// offsets of [from, from + length) not divisible by small primes, from must be at least SMALL_PRIMES_LIMIT
+static vector<size_t> sieve_candidates(const BigInteger& from, size_t length) {
+    const auto& small = small_primes();
+    auto remainders = small.remainders(from);
+    vector<bool> composite(length, false);
+    for (size_t i = 0; i < small.primes.size(); ++i) {
+        unsigned long long prime = small.primes[i];
+        for (size_t offset = (prime - remainders[i]) % prime; offset < length; offset += prime) {
+            composite[offset] = true;
+        }
+    }
+
+    vector<size_t> result;
+    for (size_t offset = 0; offset < length; ++offset) {
+        if (!composite[offset]) result.push_back(offset);
+    }
+    return result;
+}
+
+vector<BigInteger> probable_primes_in_range(const BigInteger& from, size_t length, size_t threads_count) {
+    vector<BigInteger> result;
+    if (from < SMALL_PRIMES_LIMIT) {
+        // small primes themselves would be sieved out
+        for (size_t offset = 0; offset < length; ++offset) {
+            if (from + offset >= SMALL_PRIMES_LIMIT) {
+                auto rest = probable_primes_in_range(from + offset, length - offset, threads_count);
+                result.insert(result.end(), rest.begin(), rest.end());
+                break;
+            }
+            if (is_probable_prime(from + offset)) result.push_back(from + offset);
+        }
+        return result;
+    }
+
+    vector<size_t> candidates = sieve_candidates(from, length);
+    vector<char> passed(candidates.size(), false);
+    parallel_for(candidates.size(), threads_count, [&](size_t i) {
+        passed[i] = is_probable_prime(from + candidates[i]);
+    });
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (passed[i]) result.push_back(from + candidates[i]);
+    }
+    return result;
+}
+
+// the expected distance between primes of n digits is about 2.3 * n
+const size_t WINDOW_PER_DIGIT = 32;
+const size_t MIN_WINDOW = 256;
+
+BigInteger next_prime(const BigInteger& value, size_t threads_count) {
+    if (threads_count == 0) throw InvalidArgumentException("0 threads", "at least one thread");
+    BigInteger from = value + 1;
+    if (from < SMALL_PRIMES_LIMIT) {
+        while (!is_probable_prime(from)) ++from;
+        return from;
+    }
+
+    size_t window = std::max(MIN_WINDOW, WINDOW_PER_DIGIT * value.size());
+    while (true) {
+        // the candidates are tested in order, threads_count at a time
+        vector<size_t> candidates = sieve_candidates(from, window);
+        for (size_t begin = 0; begin < candidates.size(); begin += threads_count) {
+            size_t count = std::min(threads_count, candidates.size() - begin);
+            vector<char> passed(count, false);
+            parallel_for(count, count, [&](size_t i) {
+                passed[i] = is_probable_prime(from + candidates[begin + i]);
+            });
+            for (size_t i = 0; i < count; ++i) {
+                if (passed[i]) return from + candidates[begin + i];
+            }
+        }
+        from += window;
+    }
+}
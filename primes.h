@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+#include "biginteger.h"
+
+using std::vector;
+
+// primes below this limit are used for trial division and sieving
+const unsigned long long SMALL_PRIMES_LIMIT = 1000;
+
+// all the primes not greater than limit in increasing order (sieve of Eratosthenes over odd numbers)
+vector<unsigned long long> primes_up_to(unsigned long long limit);
+
+// value % moduli[i] for every modulus below 2^32 in one pass over the digits of non-negative value
+vector<unsigned long long> remainders_by_words(const BigInteger& value, const vector<unsigned long long>& moduli);
+
+// Miller-Rabin test to the given base, value must be odd and greater than 2
+bool is_strong_probable_prime(const BigInteger& value, const BigInteger& base);
+
+// Baillie-PSW test: trial division by small primes, strong test to base 2 and strong Lucas test.
+// It has no known counterexamples, small values (below SMALL_PRIMES_LIMIT^2) are checked exactly
+bool is_probable_prime(const BigInteger& value);
+
+// all the probable primes in [from, from + length) in increasing order:
+// multiples of small primes are sieved out, the rest are tested on threads_count threads
+vector<BigInteger> probable_primes_in_range(const BigInteger& from, size_t length, size_t threads_count=1);
+
+// the least probable prime greater than value, candidates are tested threads_count at a time
+BigInteger next_prime(const BigInteger& value, size_t threads_count=1);
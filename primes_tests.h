@@ -0,0 +1,88 @@
+#pragma once
+
+#include "primes.h"
+
+TEST(PrimesTests, PrimesUpTo) {
+    ASSERT_TRUE(primes_up_to(0).empty());
+    ASSERT_TRUE(primes_up_to(1).empty());
+    ASSERT_EQ(vector<unsigned long long>({2}), primes_up_to(2));
+    ASSERT_EQ(vector<unsigned long long>({2, 3, 5, 7, 11, 13, 17, 19, 23, 29}), primes_up_to(30));
+    ASSERT_EQ(vector<unsigned long long>({2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31}), primes_up_to(31));
+}
+
+TEST(PrimesTests, PrimesCount) {
+    ASSERT_EQ(168, primes_up_to(1000).size());
+    ASSERT_EQ(78'498, primes_up_to(1'000'000).size());
+    ASSERT_EQ(999'983, primes_up_to(1'000'000).back());
+}
+
+TEST(PrimesTests, RemaindersByWords) {
+    vector<unsigned long long> moduli = {2, 3, 7, 1'000'000'007, 4'294'967'291};
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        BigInteger value = random_bigint(1 + 10 * i);
+        auto remainders = remainders_by_words(value, moduli);
+        for (size_t j = 0; j < moduli.size(); ++j) {
+            ASSERT_EQ(value % BigInteger(moduli[j]), remainders[j]);
+        }
+    }
+}
+
+TEST(PrimesTests, IsProbablePrimeSmall) {
+    auto primes = primes_up_to(20'000);
+    size_t next = 0;
+    for (long long value = -5; value <= 20'000; ++value) {
+        bool prime = next < primes.size() && primes[next] == static_cast<unsigned long long>(value);
+        if (prime) ++next;
+        ASSERT_EQ(prime, is_probable_prime(value)) << value;
+    }
+}
+
+TEST(PrimesTests, IsProbablePrimeLarge) {
+    ASSERT_TRUE(is_probable_prime(1'000'000'007));
+    ASSERT_TRUE(is_probable_prime(BigInteger::power(2, 127) - 1));
+    ASSERT_TRUE(is_probable_prime(BigInteger::power(2, 521) - 1));
+    ASSERT_FALSE(is_probable_prime(BigInteger::power(2, 523) - 1));
+    ASSERT_FALSE(is_probable_prime((BigInteger::power(2, 127) - 1) * 1'000'000'007));
+    ASSERT_FALSE(is_probable_prime(BigInteger(1'000'000'007) * 1'000'000'007));
+}
+
+TEST(PrimesTests, StrongPseudoprimes) {
+    // strong pseudoprimes to base 2, Carmichael numbers and a square of a Wieferich prime
+    for (long long value : {2047ll, 3277ll, 4033ll, 4681ll, 8321ll, 561ll, 1105ll, 1729ll,
+            3215031751ll, 3825123056546413051ll, 1093ll * 1093}) {
+        ASSERT_FALSE(is_probable_prime(value)) << value;
+    }
+    ASSERT_TRUE(is_strong_probable_prime(2047, 2));
+    ASSERT_FALSE(is_strong_probable_prime(2047, 3));
+    ASSERT_TRUE(is_strong_probable_prime(1093ll * 1093, 2));
+    ASSERT_THROW(is_strong_probable_prime(10, 2), InvalidArgumentException);
+}
+
+TEST(PrimesTests, ProbablePrimesInRange) {
+    vector<BigInteger> expected;
+    for (auto prime : primes_up_to(3000)) {
+        if (prime >= 900) expected.push_back(prime);
+    }
+    ASSERT_EQ(expected, probable_primes_in_range(900, 2101));
+    ASSERT_EQ(expected, probable_primes_in_range(900, 2101, 3));
+}
+
+TEST(PrimesTests, ProbablePrimesInRangeLarge) {
+    // above SMALL_PRIMES_LIMIT^2 the candidates go through the Baillie-PSW test
+    vector<BigInteger> expected;
+    for (auto prime : primes_up_to(1'003'000)) {
+        if (prime >= 1'000'000) expected.push_back(prime);
+    }
+    ASSERT_EQ(expected, probable_primes_in_range(1'000'000, 3001, 2));
+}
+
+TEST(PrimesTests, NextPrime) {
+    ASSERT_EQ(2, next_prime(-10));
+    ASSERT_EQ(2, next_prime(1));
+    ASSERT_EQ(3, next_prime(2));
+    ASSERT_EQ(1009, next_prime(997));
+    ASSERT_EQ(1'000'000'007, next_prime(1'000'000'000));
+    ASSERT_EQ(BigInteger::power(10, 40) + 121, next_prime(BigInteger::power(10, 40)));
+    ASSERT_EQ(BigInteger::power(10, 40) + 121, next_prime(BigInteger::power(10, 40), 4));
+    ASSERT_EQ(BigInteger::power(10, 100) + 267, next_prime(BigInteger::power(10, 100) + 200));
+}
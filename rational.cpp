@@ -1,9 +1,19 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
 #include "rational.h"
+#include "stats.h"
 
 void Rational::reduct() {
+    BIGINT_STATS_SCOPE(BigIntOperation::Reduct, std::max(numerator.size(), denominator.size()));
     BigInteger to_reduct = gcd(numerator, denominator);
-    numerator /= to_reduct;
-    denominator /= to_reduct;
+    // both divisions are exact, and usually there is nothing to cancel
+    if (to_reduct != 1 && to_reduct != -1) {
+        numerator = BigInteger::divexact(numerator, to_reduct);
+        denominator = BigInteger::divexact(denominator, to_reduct);
+    }
 
     if (denominator.is_negative()) {
         numerator.invert_sign();
@@ -13,23 +23,94 @@ void Rational::reduct() {
 
 Rational::Rational() : numerator(0), denominator(1) {}
 
-Rational::Rational(long long value) : Rational(BigInteger(value)) {}
+Rational::Rational(int128_t value) : numerator(value), denominator(1) {}
+
+Rational::Rational(uint128_t value) : numerator(value), denominator(1) {}
+
+Rational::Rational(const BigInteger& value) : numerator(value), denominator(1) {}
+
+Rational::Rational(double value) {
+    const int fraction_bits = std::numeric_limits<double>::digits - 1;
+    const int exponent_bias = std::numeric_limits<double>::max_exponent - 1;
+    const unsigned long long exponent_mask = (1ull << (sizeof(double) * 8 - 1 - fraction_bits)) - 1;
+
+    auto bits = std::bit_cast<unsigned long long>(value);
+    bool negative = bits >> (sizeof(double) * 8 - 1);
+    unsigned long long biased_exponent = (bits >> fraction_bits) & exponent_mask;
+    unsigned long long mantissa = bits & ((1ull << fraction_bits) - 1);
+
+    if (biased_exponent == exponent_mask) throw InvalidInputException(std::to_string(value));
+
+    // value is mantissa * 2^exponent, subnormal numbers have no implicit leading bit
+    long long exponent = 1 - exponent_bias - fraction_bits;
+    if (biased_exponent != 0) {
+        mantissa |= 1ull << fraction_bits;
+        exponent += biased_exponent - 1;
+    }
+
+    if (mantissa == 0) {
+        numerator = 0;
+        denominator = 1;
+        return;
+    }
 
-Rational::Rational(const BigInteger& value) : Rational(value, 1) {}
+    // denominator is a power of two, so cancelling twos makes the fraction irreducible
+    if (exponent < 0) {
+        int cancelled = std::min<long long>(std::countr_zero(mantissa), -exponent);
+        mantissa >>= cancelled;
+        exponent += cancelled;
+    }
+
+    numerator = mantissa;
+    if (negative) numerator.invert_sign();
+    if (exponent >= 0) {
+        numerator *= power_of_two(exponent);
+        denominator = 1;
+    } else {
+        denominator = power_of_two(-exponent);
+    }
+}
+
+Rational::Rational(long double value) {
+    if (!std::isfinite(value)) throw InvalidInputException(std::to_string(value));
+
+    // value is fraction * 2^exponent with |fraction| in [0.5, 1), and fraction * 2^digits is an integer
+    const int digits = std::numeric_limits<long double>::digits;
+    static_assert(digits <= 128, "the mantissa of long double should fit into uint128_t");
+    int exponent = 0;
+    long double fraction = std::frexp(std::fabs(value), &exponent);
+    numerator = static_cast<uint128_t>(std::ldexp(fraction, digits));
+    if (value < 0) numerator.invert_sign();
+    exponent -= digits;
+    if (exponent >= 0) {
+        numerator *= power_of_two(exponent);
+        denominator = 1;
+    } else {
+        denominator = power_of_two(-exponent);
+        reduct();
+    }
+}
 
 Rational::Rational(const BigInteger& numerator, const BigInteger& denominator) : numerator(numerator), denominator(denominator) {
     reduct();
 }
 
 Rational& Rational::operator+=(const Rational& other) {
-    numerator = numerator * other.denominator + denominator * other.numerator;
+    if (this == &other) return *this += Rational(other);
+    numerator *= other.denominator;
+    BigInteger::addmul(numerator, denominator, other.numerator);
     denominator *= other.denominator;
     reduct();
     return *this;
 }
 
 Rational& Rational::operator-=(const Rational& other) {
-    return *this += -other;
+    if (this == &other) return *this = Rational();
+    numerator *= other.denominator;
+    BigInteger::submul(numerator, denominator, other.numerator);
+    denominator *= other.denominator;
+    reduct();
+    return *this;
 }
 
 Rational& Rational::operator*=(const Rational& other) {
@@ -58,71 +139,184 @@ string Rational::toString() const {
 }
 
 string Rational::asDecimal(size_t precision) const {
-    // answer * power(10, precision) is around numerator / denominator
-    // so let's calculate it this way
-    // use precision + 1 to do correct round up/down
-    BigInteger additional = BigInteger::power(10, precision + 1);
+    // answer * 10^precision is numerator / denominator rounded to the nearest integer,
+    // multiplying by a power of ten is just a shift of decimal digits
+    BigInteger scaled = numerator;
+    if (scaled.is_negative()) scaled.invert_sign();
+    scaled.shift(precision);
 
-    // pre_divided is almost what we need. now only do correct round and divide by 10
-    BigInteger pre_divided = ((numerator * additional) / denominator);
-    if (pre_divided.is_negative()) pre_divided.invert_sign();
+    BigInteger divided;
+    BigInteger rest;
+    BigInteger::divmod(scaled, denominator, divided, rest);
+    // round half up
+    rest += rest;
+    if (rest >= denominator) ++divided;
 
-    // divided is the answer string except for decimal dot
-    string divided = ((pre_divided + 5) / 10).toString();
+    // digits is the answer string except for decimal dot
+    string digits = divided.toString();
     string result = "";
     if (numerator.is_negative()) result = "-";
 
     // now add the dot in the correct place
-    if (divided.size() <= precision) {
+    if (digits.size() <= precision) {
         result += "0.";
-        for (size_t i = divided.size(); i < precision; ++i) {
+        for (size_t i = digits.size(); i < precision; ++i) {
             result += '0';
         }
     }
-    for (size_t i = 0; i < divided.size(); ++i) { 
-        result += divided[i];
-        if (divided.size() - i - 1 == precision && precision > 0) {
+    for (size_t i = 0; i < digits.size(); ++i) { 
+        result += digits[i];
+        if (digits.size() - i - 1 == precision && precision > 0) {
             result += '.';
         }
     }
     return result;
 }
 
-BigInteger Rational::to_int_binary_shifted(long long binary_shift) const {
-    BigInteger exponent = BigInteger::power(2, abs(binary_shift));
-    BigInteger result = numerator;
-    if (binary_shift < 0) {
-        result /= exponent;
-    } else {
-        result *= exponent;
+void Rational::flush_decimal(std::ostream& output, string& pending) {
+    // rounding carry stops at the last digit which is not 9, everything before it is final
+    size_t last_not_nine = pending.size();
+    for (size_t i = pending.size(); i > 0; --i) {
+        if (pending[i - 1] != '9' && pending[i - 1] != '.') {
+            last_not_nine = i - 1;
+            break;
+        }
+    }
+    if (last_not_nine == pending.size()) return;
+
+    output.write(pending.data(), last_not_nine);
+    pending.erase(0, last_not_nine);
+}
+
+void Rational::round_up_decimal(string& pending) {
+    for (size_t i = pending.size(); i > 0; --i) {
+        if (pending[i - 1] == '.') continue;
+        if (pending[i - 1] != '9') {
+            ++pending[i - 1];
+            return;
+        }
+        pending[i - 1] = '0';
+    }
+    pending.insert(pending.begin(), '1');
+}
+
+std::ostream& Rational::writeDecimal(std::ostream& output, size_t precision) const {
+    BigInteger rest = numerator;
+    if (rest.is_negative()) rest.invert_sign();
+    BigInteger integer_part;
+    BigInteger::divmod(rest, denominator, integer_part, rest);
+
+    if (numerator.is_negative()) output << '-';
+    // digits which are not written yet since the rounding may still change them
+    string pending = integer_part.toString();
+    if (precision > 0) pending += '.';
+
+    // long division producing DECIMAL_CHUNK digits after the dot at a time
+    for (size_t written = 0; written < precision; ) {
+        size_t chunk = std::min(DECIMAL_CHUNK, precision - written);
+        rest.shift(chunk);
+        BigInteger chunk_value;
+        BigInteger::divmod(rest, denominator, chunk_value, rest);
+
+        string chunk_digits = chunk_value.toString();
+        pending.append(chunk - chunk_digits.size(), '0');
+        pending += chunk_digits;
+        written += chunk;
+
+        flush_decimal(output, pending);
+    }
+
+    rest += rest;
+    if (rest >= denominator) round_up_decimal(pending);
+    output << pending;
+    return output;
+}
+
+BigInteger Rational::power_of_two(size_t exponent) {
+    BigInteger result = 1;
+    BigInteger current_power = 2;
+    while (exponent > 0) {
+        if (exponent & 1) result *= current_power;
+        exponent >>= 1;
+        if (exponent > 0) current_power *= current_power;
     }
-    result /= denominator;
     return result;
 }
 
-Rational::operator double() const {
+template<typename T>
+T Rational::to_floating() const {
     if (numerator.is_zero()) return 0;
-    // double is 52 bits of mantissa and 11 bits of exponent
-    // first using bin_search find the best exponent
-    long long exponent_l = -1024;
-    long long exponent_r = 1024;
-    while(exponent_l != exponent_r - 1) {
-        long long m = (exponent_l + exponent_r) / 2;
-        
-        BigInteger result = to_int_binary_shifted(m);
-        if (result.is_negative()) result.invert_sign();
-
-        if (result >= DOUBLE_MAX) {
-            exponent_r = m;
-        } else {
-            exponent_l = m;
-        }
+
+    const int mantissa_bits = std::numeric_limits<T>::digits;
+    const int min_exponent = std::numeric_limits<T>::min_exponent;
+    const int max_exponent = std::numeric_limits<T>::max_exponent;
+    const T sign = numerator.is_negative() ? -1 : 1;
+
+    // |numerator| is in [10^(size - 1), 10^size), the same for denominator,
+    // so the sizes give log2 of the value up to 2 * log2(10)
+    const double log2_10 = 3.321928094887362;
+    long long size_difference = static_cast<long long>(numerator.size()) - static_cast<long long>(denominator.size());
+    double log2_lower = (size_difference - 1) * log2_10;
+    double log2_upper = (size_difference + 1) * log2_10;
+
+    if (log2_lower >= max_exponent) return sign * std::numeric_limits<T>::infinity();
+    // less than a half of the smallest subnormal number rounds to zero
+    if (log2_upper <= min_exponent - mantissa_bits - 1) return sign * 0;
+
+    // scale the value so that its integer part has at least mantissa_bits + 2 bits
+    // (mantissa, guard bit and one more to be sure) and at most mantissa_bits + 10
+    long long binary_shift = mantissa_bits + 2 - static_cast<long long>(floor(log2_lower));
+
+    BigInteger scaled = numerator;
+    if (scaled.is_negative()) scaled.invert_sign();
+    BigInteger divisor = denominator;
+    if (binary_shift > 0) {
+        scaled *= power_of_two(binary_shift);
+    } else {
+        divisor *= power_of_two(-binary_shift);
     }
-    // then save the answer as double
-    auto mantissa = to_int_binary_shifted(exponent_l);
-    if (mantissa >= DOUBLE_MAX) throw TooBigCastException(mantissa, typeid(double));
-    
-    return ldexp(static_cast<long long>(mantissa), -exponent_l);
+
+    BigInteger quotient;
+    BigInteger lost;
+    BigInteger::divmod(scaled, divisor, quotient, lost);
+    // the rest of the value which is lost in integer division works as a sticky bit
+    bool inexact = !lost.is_zero();
+
+    // quotient is at most 2^74, so it fits into 128 bits
+    uint128_t integer_part = quotient.to<uint128_t>();
+
+    int bit_length = 0;
+    while ((integer_part >> bit_length) > 0) ++bit_length;
+
+    // value is in [2^leading_exponent, 2^(leading_exponent + 1))
+    long long leading_exponent = bit_length - 1 - binary_shift;
+    long long precision = mantissa_bits;
+    // subnormal numbers have fewer significant bits
+    if (leading_exponent < min_exponent - 1) precision -= min_exponent - 1 - leading_exponent;
+    if (precision < 0) return sign * 0;
+
+    int dropped_bits = bit_length - precision;
+    uint128_t mantissa = integer_part >> dropped_bits;
+    uint128_t rest = integer_part & ((static_cast<uint128_t>(1) << dropped_bits) - 1);
+    uint128_t half = static_cast<uint128_t>(1) << (dropped_bits - 1);
+
+    if (rest > half || (rest == half && (inexact || (mantissa & 1)))) ++mantissa;
+
+    // mantissa has at most precision bits now (or it is exactly 2^precision), so ldexp is exact
+    // unless the value is too big, and then it becomes infinity
+    return sign * std::ldexp(static_cast<T>(mantissa), static_cast<int>(dropped_bits - binary_shift));
+}
+
+Rational::operator float() const {
+    return to_floating<float>();
+}
+
+Rational::operator double() const {
+    return to_floating<double>();
+}
+
+Rational::operator long double() const {
+    return to_floating<long double>();
 }
 
 Rational::operator bool() const {
@@ -137,6 +331,12 @@ bool Rational::is_negative() const {
     return numerator.is_negative();
 }
 
+size_t Rational::hash() const {
+    // the combination of hash_combine from Boost
+    size_t denominator_hash = denominator.hash();
+    return numerator.hash() ^ (denominator_hash + 0x9e3779b97f4a7c15ull + (denominator_hash << 6) + (denominator_hash >> 2));
+}
+
 strong_ordering operator<=>(const Rational& left, const Rational& right) {
     auto left_bi = left.numerator * right.denominator;
     auto right_bi = right.numerator * left.denominator;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <compare>
+#include <concepts>
 #include <string>
 #include <iostream>
 
@@ -14,14 +15,37 @@ class Rational {
     BigInteger numerator;
     BigInteger denominator;
 
+    // writeDecimal streams the digits by chunks of this size
+    static constexpr size_t DECIMAL_CHUNK = 1000;
+
     void reduct();
 
-    BigInteger to_int_binary_shifted(long long binary_shift) const;
+    // writes the digits of pending decimal which can't be changed by rounding anymore
+    static void flush_decimal(std::ostream& output, string& pending);
+
+    static void round_up_decimal(string& pending);
+
+    static BigInteger power_of_two(size_t exponent);
+
+    // Correctly rounded (to nearest, ties to even) conversion to a binary floating point type
+    template<typename T>
+    T to_floating() const;
   public:
 
     Rational();
 
-    Rational(long long value);
+    template<std::integral T>
+    Rational(T value);
+
+    Rational(int128_t value);
+
+    Rational(uint128_t value);
+
+    // exact value of the double, throws InvalidInputException for infinities and NaN
+    Rational(double value);
+
+    // exact value of the long double, throws InvalidInputException for infinities and NaN
+    Rational(long double value);
 
     Rational(const BigInteger& value);
 
@@ -41,19 +65,32 @@ class Rational {
 
     string asDecimal(size_t precision=0) const;
 
+    // the same as asDecimal, but generates digits incrementally, good for huge precisions
+    std::ostream& writeDecimal(std::ostream& output, size_t precision=0) const;
+
+    explicit operator float() const;
+
     explicit operator double() const;
 
+    explicit operator long double() const;
+
     explicit operator bool() const;
 
     bool is_zero() const;
 
     bool is_negative() const;
+
+    // values are kept reduced, so equal values have equal hashes
+    size_t hash() const;
     
     friend strong_ordering operator<=>(const Rational& left, const Rational& right);
 
     friend bool operator==(const Rational& left, const Rational& right);
 };
 
+template<std::integral T>
+Rational::Rational(T value) : numerator(value), denominator(1) {}
+
 bool operator!=(const BigInteger& left, const BigInteger& right);
 
 Rational operator+(const Rational& left, const Rational& right);
@@ -64,7 +101,11 @@ Rational operator*(const Rational& left, const Rational& right);
 
 Rational operator/(const Rational& left, const Rational& right);
 
-const BigInteger DOUBLE_MAX = BigInteger(1ll << 52);
-
 std::ostream& operator<<(std::ostream& output, const Rational& other);
 
+template<>
+struct std::hash<Rational> {
+    size_t operator()(const Rational& value) const noexcept {
+        return value.hash();
+    }
+};
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <sstream>
+#include <unordered_map>
 #include <random>
 
 #include "bigint_test_helper.h"
@@ -123,6 +124,18 @@ TEST(RatOperatorTests, PlusEqToZero) {
     ASSERT_EQ(0, a);
 }
 
+TEST(RatOperatorTests, PlusEqSelf) {
+    Rational a(BigInteger(-3), BigInteger(4));
+    a += a;
+    ASSERT_EQ(Rational(BigInteger(-3), BigInteger(2)), a);
+}
+
+TEST(RatOperatorTests, MinusEqSelf) {
+    Rational a(BigInteger(-3), BigInteger(4));
+    a -= a;
+    ASSERT_EQ(0, a);
+}
+
 TEST(RatOperatorTests, PlusEqTime) {
     int total_time = 0;
     int time_treshold = 2000;
@@ -685,3 +698,206 @@ TEST(RatMethodsTests, IsNegativeAfterSum) {
     ASSERT_FALSE(a.is_negative());
 }
 
+
+TEST(RatOperatorTests, DoubleCastExact) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        long long numerator = random_value();
+        long long denominator = 0;
+        while (denominator == 0) denominator = random_value();
+        Rational r = numerator;
+        r /= denominator;
+        ASSERT_EQ(static_cast<double>(numerator) / static_cast<double>(denominator), static_cast<double>(r));
+    }
+}
+
+TEST(RatOperatorTests, DoubleCastTiesToEven) {
+    Rational down = BigInteger((1ll << 53) + 1);
+    ASSERT_EQ(9007199254740992.0, static_cast<double>(down));
+    Rational up = BigInteger((1ll << 53) + 3);
+    ASSERT_EQ(9007199254740996.0, static_cast<double>(up));
+}
+
+TEST(RatOperatorTests, DoubleCastNeg) {
+    Rational r = -1;
+    r /= 3;
+    ASSERT_EQ(-1.0 / 3, static_cast<double>(r));
+}
+
+TEST(RatOperatorTests, DoubleCastInfinity) {
+    Rational r = BigInteger::power(10, 400);
+    ASSERT_EQ(std::numeric_limits<double>::infinity(), static_cast<double>(r));
+    ASSERT_EQ(-std::numeric_limits<double>::infinity(), static_cast<double>(-r));
+}
+
+TEST(RatOperatorTests, DoubleCastMax) {
+    Rational r = BigInteger::power(2, 1024) - BigInteger::power(2, 971);
+    ASSERT_EQ(std::numeric_limits<double>::max(), static_cast<double>(r));
+
+    // exactly halfway between the maximum and 2^1024, so it rounds to even, which overflows
+    Rational halfway = BigInteger::power(2, 1024) - BigInteger::power(2, 970);
+    ASSERT_EQ(std::numeric_limits<double>::infinity(), static_cast<double>(halfway));
+}
+
+TEST(RatOperatorTests, DoubleCastSubnormal) {
+    Rational r = 1;
+    r /= BigInteger::power(2, 1074);
+    ASSERT_EQ(std::numeric_limits<double>::denorm_min(), static_cast<double>(r));
+
+    Rational almost = 3;
+    almost /= BigInteger::power(2, 1076);
+    ASSERT_EQ(std::numeric_limits<double>::denorm_min(), static_cast<double>(almost));
+
+    Rational half = 1;
+    half /= BigInteger::power(2, 1075);
+    ASSERT_EQ(0.0, static_cast<double>(half));
+}
+
+TEST(RatOperatorTests, FloatCast) {
+    Rational r = 1;
+    r /= 3;
+    ASSERT_EQ(1.0f / 3, static_cast<float>(r));
+}
+
+TEST(RatOperatorTests, LongDoubleCast) {
+    Rational r = 2;
+    r /= 7;
+    ASSERT_EQ(2.0l / 7, static_cast<long double>(r));
+}
+
+string write_decimal(const Rational& value, size_t precision) {
+    std::stringstream output;
+    value.writeDecimal(output, precision);
+    return output.str();
+}
+
+TEST(RatMethodTests, WriteDecimal) {
+    Rational a = 11;
+    a /= 20;
+    ASSERT_EQ("0.55000", write_decimal(a, 5));
+    ASSERT_EQ("1", write_decimal(a, 0));
+}
+
+TEST(RatMethodTests, WriteDecimalNegative) {
+    Rational a = -1;
+    a /= 20;
+    ASSERT_EQ("-0.05", write_decimal(a, 2));
+}
+
+TEST(RatMethodTests, WriteDecimalCarry) {
+    Rational a = 99996;
+    a /= 10000;
+    ASSERT_EQ("10.000", write_decimal(a, 3));
+}
+
+TEST(RatMethodTests, WriteDecimalRandom) {
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        Rational a = random_rational(30);
+        ASSERT_EQ(a.asDecimal(i * 3), write_decimal(a, i * 3));
+    }
+}
+
+TEST(RatMethodTests, WriteDecimalLongCarry) {
+    // 1 - 10^-2500 is written as 2500 nines, rounding to fewer digits carries through all of them
+    Rational a = BigInteger::power(10, 2500) - 1;
+    a /= BigInteger::power(10, 2500);
+    string expected = "1." + string(2400, '0');
+    ASSERT_EQ(expected, write_decimal(a, 2400));
+    ASSERT_EQ(expected, a.asDecimal(2400));
+}
+
+TEST(RatMethodTests, WriteDecimalLong) {
+    Rational a = 1;
+    a /= 7;
+    string result = write_decimal(a, 3000);
+    ASSERT_EQ(a.asDecimal(3000), result);
+    ASSERT_EQ("0.142857142857", result.substr(0, 14));
+}
+
+TEST(RatConstructorTests, DoubleConstructor) {
+    Rational a = 0.5;
+    Rational expected = 1;
+    expected /= 2;
+    ASSERT_EQ(expected, a);
+}
+
+TEST(RatConstructorTests, DoubleConstructorInexactDecimal) {
+    Rational a = 0.1;
+    ASSERT_EQ("3602879701896397/36028797018963968", a.toString());
+}
+
+TEST(RatConstructorTests, DoubleConstructorInteger) {
+    Rational a = -3.0;
+    ASSERT_EQ(-3, a);
+    Rational b = 1e300;
+    ASSERT_EQ(Rational(BigInteger("1000000000000000052504760255204420248704468581108159154915854115511802457988908195786371375080447864043704443832883878176942523235360430575644792184786706982848387200926575803737830233794788090059368953234970799945081119038967640880074652742780142494579258788820056842838115669472196386865459400540160")), b);
+}
+
+TEST(RatConstructorTests, DoubleConstructorZero) {
+    Rational a = 0.0;
+    Rational b = -0.0;
+    ASSERT_EQ(0, a);
+    ASSERT_EQ(0, b);
+    ASSERT_FALSE(b.is_negative());
+}
+
+TEST(RatConstructorTests, DoubleConstructorSubnormal) {
+    Rational a = std::numeric_limits<double>::denorm_min();
+    Rational expected = 1;
+    expected /= BigInteger::power(2, 1074);
+    ASSERT_EQ(expected, a);
+}
+
+TEST(RatConstructorTests, DoubleConstructorRoundTrip) {
+    std::uniform_real_distribution<double> distribution(-1e10, 1e10);
+    for (int i = 0; i < RANDOM_TRIES_COUNT; ++i) {
+        double value = distribution(test_random);
+        Rational a = value;
+        ASSERT_EQ(value, static_cast<double>(a));
+    }
+}
+
+TEST(RatConstructorTests, DoubleConstructorNotFinite) {
+    ASSERT_THROW(Rational(std::numeric_limits<double>::infinity()), InvalidInputException);
+    ASSERT_THROW(Rational(std::numeric_limits<double>::quiet_NaN()), InvalidInputException);
+}
+
+TEST(RatConstructorTests, LongDoubleConstructor) {
+    Rational a(1.5L);
+    Rational b = -2.5L;
+    ASSERT_EQ(Rational(3, 2), a);
+    ASSERT_EQ(Rational(-5, 2), b);
+    ASSERT_EQ(0, Rational(0.0L));
+    ASSERT_EQ(Rational(0.1), Rational(static_cast<long double>(0.1)));
+    ASSERT_EQ(Rational(BigInteger::power(2, 200)), Rational(std::ldexp(1.0L, 200)));
+
+    // every bit of the long double mantissa is kept
+    long double third = 1.0L / 3;
+    ASSERT_EQ(third, static_cast<long double>(Rational(third)));
+    ASSERT_THROW(Rational(std::numeric_limits<long double>::infinity()), InvalidInputException);
+}
+
+TEST(RatConstructorTests, IntegralConstructors) {
+    Rational a = 179u;
+    Rational b = static_cast<short>(-179);
+    Rational c = std::numeric_limits<unsigned long long>::max();
+    ASSERT_EQ(179, a);
+    ASSERT_EQ(-179, b);
+    ASSERT_EQ("18446744073709551615", c.toString());
+}
+
+TEST(RatMethodTests, Hash) {
+    std::hash<Rational> hasher;
+    Rational a = Rational(6) / Rational(-4);
+    Rational b = Rational(-3) / Rational(2);
+    ASSERT_EQ(hasher(a), hasher(b));
+    ASSERT_NE(hasher(a), hasher(-a));
+    ASSERT_NE(hasher(Rational(2) / Rational(3)), hasher(Rational(3) / Rational(2)));
+    ASSERT_EQ(hasher(Rational(0)), hasher(Rational(0) / Rational(-5)));
+
+    std::unordered_map<Rational, int> counts;
+    for (int i = 1; i <= 100; ++i) {
+        ++counts[Rational(i) / Rational(2 * i)];
+    }
+    ASSERT_EQ(1, counts.size());
+    ASSERT_EQ(100, counts[Rational(1) / Rational(2)]);
+}
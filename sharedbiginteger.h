@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <compare>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#include "biginteger.h"
+
+// Handle to a BigInteger which is shared between copies: copying only changes an atomic reference
+// counter, so a big constant may be passed to many threads and containers for free. The value is
+// immutable through the handle except mutate(), which copies the digits first if they are shared
+// (copy on write). Handles may be copied and destroyed concurrently, as std::shared_ptr
+class SharedBigInteger {
+  private:
+    struct Entry {
+        BigInteger value;
+        // hash of value computed by the first of the sharing handles which needed it, NO_HASH until then
+        std::atomic<size_t> hash;
+
+        template<typename T>
+        explicit Entry(T&& source) : value(std::forward<T>(source)), hash(NO_HASH) {}
+    };
+
+    static const size_t NO_HASH = 0;
+
+    std::shared_ptr<Entry> entry;
+
+  public:
+    SharedBigInteger() : entry(std::make_shared<Entry>(BigInteger())) {}
+
+    SharedBigInteger(const BigInteger& source) : entry(std::make_shared<Entry>(source)) {}
+
+    // the digits are taken from source, which is left equal to zero
+    SharedBigInteger(BigInteger&& source) : entry(std::make_shared<Entry>(std::move(source))) {}
+
+    template<native_integer T>
+    SharedBigInteger(T source) : entry(std::make_shared<Entry>(BigInteger(source))) {}
+
+    const BigInteger& get() const {
+        return entry->value;
+    }
+
+    operator const BigInteger&() const {
+        return entry->value;
+    }
+
+    const BigInteger& operator*() const {
+        return entry->value;
+    }
+
+    const BigInteger* operator->() const {
+        return &entry->value;
+    }
+
+    // the only owner changes the value in place, otherwise it gets a copy of its own first.
+    // The reference is valid until this handle is copied, assigned or destroyed, and the value
+    // must not be changed through it after hash() is called
+    BigInteger& mutate() {
+        if (entry.use_count() != 1) {
+            entry = std::make_shared<Entry>(entry->value);
+        } else {
+            // use_count() is a relaxed load, so the reads of the handles which were just released
+            // have to happen before the value is changed
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+        entry->hash.store(NO_HASH, std::memory_order_relaxed);
+        return entry->value;
+    }
+
+    // number of handles sharing the value
+    long use_count() const {
+        return entry.use_count();
+    }
+
+    bool shares_with(const SharedBigInteger& other) const {
+        return entry == other.entry;
+    }
+
+    // the same as get().hash(), but it is computed once for all the sharing handles
+    // (values which really hash to NO_HASH are just hashed every time)
+    size_t hash() const {
+        size_t result = entry->hash.load(std::memory_order_relaxed);
+        if (result == NO_HASH) {
+            result = entry->value.hash();
+            entry->hash.store(result, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    friend bool operator==(const SharedBigInteger& left, const SharedBigInteger& right) {
+        return left.shares_with(right) || left.get() == right.get();
+    }
+
+    friend strong_ordering operator<=>(const SharedBigInteger& left, const SharedBigInteger& right) {
+        return left.get() <=> right.get();
+    }
+
+    // the other operand is compared as it is, without a handle of its own
+
+    friend bool operator==(const SharedBigInteger& left, const BigInteger& right) {
+        return left.get() == right;
+    }
+
+    friend strong_ordering operator<=>(const SharedBigInteger& left, const BigInteger& right) {
+        return left.get() <=> right;
+    }
+
+    template<native_integer T>
+    friend bool operator==(const SharedBigInteger& left, T right) {
+        return left.get() == right;
+    }
+
+    template<native_integer T>
+    friend strong_ordering operator<=>(const SharedBigInteger& left, T right) {
+        return left.get() <=> right;
+    }
+};
+
+inline std::ostream& operator<<(std::ostream& output, const SharedBigInteger& source) {
+    return output << source.get();
+}
+
+template<>
+struct std::hash<SharedBigInteger> {
+    size_t operator()(const SharedBigInteger& value) const noexcept {
+        return value.hash();
+    }
+};
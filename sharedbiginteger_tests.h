@@ -0,0 +1,104 @@
+#pragma once
+
+#include <thread>
+
+#include "bigint_test_helper.h"
+#include "sharedbiginteger.h"
+
+TEST(SharedBigIntegerTests, CopiesShareDigits) {
+    SharedBigInteger a = random_bigint(1000);
+    SharedBigInteger c;
+    OperatorNewCounter cntr(true);
+    SharedBigInteger b = a;
+    c = b;
+    ASSERT_EQ(0, cntr.get_counter());
+    ASSERT_EQ(3, a.use_count());
+    ASSERT_TRUE(a.shares_with(c));
+    ASSERT_EQ(&a.get(), &c.get());
+}
+
+TEST(SharedBigIntegerTests, CopyOnWrite) {
+    BigInteger value = random_bigint(100);
+    SharedBigInteger a = value;
+    SharedBigInteger b = a;
+    b.mutate() += 1;
+    ASSERT_EQ(value, a.get());
+    ASSERT_EQ(value + 1, b.get());
+    ASSERT_FALSE(a.shares_with(b));
+    ASSERT_EQ(1, a.use_count());
+
+    // the only owner is changed in place
+    const BigInteger* address = &b.get();
+    b.mutate() *= 2;
+    ASSERT_EQ(address, &b.get());
+    ASSERT_EQ((value + 1) * 2, b.get());
+}
+
+TEST(SharedBigIntegerTests, Interoperability) {
+    SharedBigInteger a = 57;
+    SharedBigInteger b = BigInteger("1000000000000000000000");
+    ASSERT_EQ(BigInteger("1000000000000000000057"), a + b);
+    ASSERT_EQ(BigInteger(114), a * 2);
+    ASSERT_TRUE(a < b);
+    ASSERT_TRUE(a == SharedBigInteger(57));
+    ASSERT_EQ(2, a->size());
+    ASSERT_EQ("57", (*a).toString());
+    std::stringstream output;
+    output << a;
+    ASSERT_EQ("57", output.str());
+}
+
+TEST(SharedBigIntegerTests, MixedComparisons) {
+    SharedBigInteger a = 57;
+    BigInteger b = 58;
+    ASSERT_TRUE(a != b);
+    ASSERT_FALSE(b == a);
+    ASSERT_TRUE(a < b);
+    ASSERT_TRUE(b > a);
+    ASSERT_TRUE(a == b - 1);
+    ASSERT_TRUE(b - 1 == a);
+    ASSERT_EQ(strong_ordering::less, a <=> b);
+    ASSERT_EQ(strong_ordering::greater, b <=> a);
+    ASSERT_TRUE(a == 57);
+    ASSERT_TRUE(57 == a);
+    ASSERT_TRUE(a < 58ll);
+    ASSERT_TRUE(-1 < a);
+}
+
+TEST(SharedBigIntegerTests, Threads) {
+    SharedBigInteger modulus = random_bigint(500);
+    BigInteger value = random_bigint(1000);
+    BigInteger expected = value % modulus;
+    vector<BigInteger> results(8);
+    vector<std::thread> workers;
+    for (size_t i = 0; i < results.size(); ++i) {
+        workers.emplace_back([modulus, &value, &results, i]() {
+            for (int j = 0; j < 10; ++j) {
+                SharedBigInteger copy = modulus;
+                results[i] = value % copy;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& result : results) {
+        ASSERT_EQ(expected, result);
+    }
+    ASSERT_EQ(1, modulus.use_count());
+}
+
+TEST(SharedBigIntegerTests, Hash) {
+    BigInteger value = random_bigint(100);
+    SharedBigInteger a = value;
+    SharedBigInteger b = a;
+    ASSERT_EQ(value.hash(), a.hash());
+    ASSERT_EQ(value.hash(), std::hash<SharedBigInteger>()(b));
+
+    // mutation drops the cached hash
+    b.mutate() += 1;
+    ASSERT_EQ((value + 1).hash(), b.hash());
+    ASSERT_EQ(value.hash(), a.hash());
+    a.mutate() -= 1;
+    ASSERT_EQ((value - 1).hash(), a.hash());
+}
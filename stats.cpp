@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <set>
+
+#include "stats.h"
+
+namespace {
+
+struct AtomicOperationStats {
+    std::atomic<unsigned long long> calls{0};
+    std::atomic<unsigned long long> nanoseconds{0};
+    std::atomic<unsigned long long> allocated_bytes{0};
+    std::array<std::atomic<unsigned long long>, SIZE_HISTOGRAM_BUCKETS> size_histogram{};
+
+    void add_to(OperationStats& target) const {
+        target.calls += calls.load(std::memory_order_relaxed);
+        target.nanoseconds += nanoseconds.load(std::memory_order_relaxed);
+        target.allocated_bytes += allocated_bytes.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < SIZE_HISTOGRAM_BUCKETS; ++i) {
+            target.size_histogram[i] += size_histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void clear() {
+        calls.store(0, std::memory_order_relaxed);
+        nanoseconds.store(0, std::memory_order_relaxed);
+        allocated_bytes.store(0, std::memory_order_relaxed);
+        for (auto& bucket : size_histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+struct ThreadCounters;
+
+// counters of the running threads and the sum of the finished ones
+struct Registry {
+    std::mutex mutex;
+    std::set<ThreadCounters*> threads;
+    BigIntStatsSnapshot finished;
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+// counters are written only by their own thread, so the atomics are never contended
+struct ThreadCounters {
+    std::array<AtomicOperationStats, OPERATIONS_COUNT> operations;
+
+    ThreadCounters() {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        registry().threads.insert(this);
+    }
+
+    ~ThreadCounters() {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        for (size_t i = 0; i < OPERATIONS_COUNT; ++i) {
+            operations[i].add_to(registry().finished.operations[i]);
+        }
+        registry().threads.erase(this);
+    }
+};
+
+AtomicOperationStats& local_stats(BigIntOperation operation) {
+    thread_local ThreadCounters counters;
+    return counters.operations[static_cast<size_t>(operation)];
+}
+
+}
+
+string operation_name(BigIntOperation operation) {
+    switch (operation) {
+        case BigIntOperation::MultiplyFft: return "multiply_fft";
+        case BigIntOperation::MultiplyBatch: return "multiply_batch";
+        case BigIntOperation::Divide: return "divide";
+        case BigIntOperation::DivideExact: return "divide_exact";
+        case BigIntOperation::Gcd: return "gcd";
+        case BigIntOperation::Reduct: return "reduct";
+        case BigIntOperation::ToString: return "to_string";
+    }
+    return "unknown";
+}
+
+const OperationStats& BigIntStatsSnapshot::operator[](BigIntOperation operation) const {
+    return operations[static_cast<size_t>(operation)];
+}
+
+BigIntStatsSnapshot BigIntStats::snapshot() {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    BigIntStatsSnapshot result = registry().finished;
+    for (auto thread : registry().threads) {
+        for (size_t i = 0; i < OPERATIONS_COUNT; ++i) {
+            thread->operations[i].add_to(result.operations[i]);
+        }
+    }
+    return result;
+}
+
+void BigIntStats::reset() {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    registry().finished = BigIntStatsSnapshot();
+    for (auto thread : registry().threads) {
+        for (auto& operation : thread->operations) {
+            operation.clear();
+        }
+    }
+}
+
+void BigIntStats::record_call(BigIntOperation operation, size_t operand_size, unsigned long long nanoseconds) {
+    auto& stats = local_stats(operation);
+    size_t bucket = std::min<size_t>(std::bit_width(operand_size | 1) - 1, SIZE_HISTOGRAM_BUCKETS - 1);
+
+    stats.calls.fetch_add(1, std::memory_order_relaxed);
+    stats.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+    stats.size_histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void BigIntStats::record_allocation(BigIntOperation operation, size_t bytes) {
+    local_stats(operation).allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+ScopedOperationTimer::ScopedOperationTimer(BigIntOperation operation, size_t operand_size)
+    : operation(operation)
+    , operand_size(operand_size)
+    , begin(std::chrono::steady_clock::now()) {}
+
+ScopedOperationTimer::~ScopedOperationTimer() {
+    auto duration = std::chrono::steady_clock::now() - begin;
+    BigIntStats::record_call(operation, operand_size,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+
+using std::string;
+
+// Operation counters are compiled in only with -DBIGINT_STATS,
+// otherwise BigIntStats::snapshot() always returns zeroes
+
+enum class BigIntOperation {
+    MultiplyFft,
+    MultiplyBatch,
+    Divide,
+    DivideExact,
+    Gcd,
+    Reduct,
+    ToString,
+};
+
+const size_t OPERATIONS_COUNT = static_cast<size_t>(BigIntOperation::ToString) + 1;
+
+// bucket i counts operands of [2^i, 2^(i+1)) decimal digits
+const size_t SIZE_HISTOGRAM_BUCKETS = 32;
+
+string operation_name(BigIntOperation operation);
+
+struct OperationStats {
+    unsigned long long calls = 0;
+    unsigned long long nanoseconds = 0;
+    unsigned long long allocated_bytes = 0;
+    std::array<unsigned long long, SIZE_HISTOGRAM_BUCKETS> size_histogram{};
+};
+
+struct BigIntStatsSnapshot {
+    std::array<OperationStats, OPERATIONS_COUNT> operations{};
+
+    const OperationStats& operator[](BigIntOperation operation) const;
+};
+
+class BigIntStats {
+  public:
+#ifdef BIGINT_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    // sums up the counters of all threads, including already finished ones
+    static BigIntStatsSnapshot snapshot();
+
+    static void reset();
+
+    static void record_call(BigIntOperation operation, size_t operand_size, unsigned long long nanoseconds);
+
+    static void record_allocation(BigIntOperation operation, size_t bytes);
+};
+
+class ScopedOperationTimer {
+  private:
+    BigIntOperation operation;
+    size_t operand_size;
+    std::chrono::steady_clock::time_point begin;
+  public:
+    ScopedOperationTimer(BigIntOperation operation, size_t operand_size);
+
+    ~ScopedOperationTimer();
+};
+
+#ifdef BIGINT_STATS
+#define BIGINT_STATS_SCOPE(operation, operand_size) \
+    ScopedOperationTimer bigint_stats_timer(operation, operand_size)
+#define BIGINT_STATS_ALLOCATION(operation, bytes) \
+    BigIntStats::record_allocation(operation, bytes)
+#else
+#define BIGINT_STATS_SCOPE(operation, operand_size)
+#define BIGINT_STATS_ALLOCATION(operation, bytes)
+#endif
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <thread>
+
+#include "bigint_test_helper.h"
+#include "stats.h"
+
+TEST(StatsTests, Enabled) {
+    ASSERT_TRUE(BigIntStats::enabled);
+}
+
+TEST(StatsTests, Reset) {
+    BigInteger a = 179;
+    a *= 57;
+    BigIntStats::reset();
+    auto stats = BigIntStats::snapshot();
+    for (size_t i = 0; i < OPERATIONS_COUNT; ++i) {
+        ASSERT_EQ(0, stats.operations[i].calls);
+    }
+}
+
+TEST(StatsTests, Multiply) {
+    BigIntStats::reset();
+    BigInteger a = random_bigint(100);
+    a *= random_bigint(100);
+    a *= random_bigint(200);
+    auto stats = BigIntStats::snapshot()[BigIntOperation::MultiplyFft];
+    ASSERT_EQ(2, stats.calls);
+    ASSERT_LT(0, stats.allocated_bytes);
+    // 100 digits are in [64, 128) bucket and 200 digits are in [128, 256)
+    ASSERT_EQ(1, stats.size_histogram[6]);
+    ASSERT_EQ(1, stats.size_histogram[7]);
+}
+
+TEST(StatsTests, DivideAndGcd) {
+    BigIntStats::reset();
+    BigInteger a = 1791791791;
+    BigInteger b = 57;
+    a /= b;
+    a %= b;
+    auto stats = BigIntStats::snapshot();
+    ASSERT_EQ(2, stats[BigIntOperation::Divide].calls);
+
+    BigIntStats::reset();
+    gcd(a, b);
+    stats = BigIntStats::snapshot();
+    ASSERT_EQ(1, stats[BigIntOperation::Gcd].calls);
+    ASSERT_LE(1, stats[BigIntOperation::Divide].calls);
+}
+
+TEST(StatsTests, DivideExact) {
+    BigIntStats::reset();
+    Rational a(BigInteger(179 * 57), BigInteger(179 * 3));
+    auto stats = BigIntStats::snapshot();
+    ASSERT_EQ(2, stats[BigIntOperation::DivideExact].calls);
+}
+
+TEST(StatsTests, Reduct) {
+    BigIntStats::reset();
+    Rational a = 1;
+    a /= 3;
+    auto stats = BigIntStats::snapshot();
+    ASSERT_EQ(1, stats[BigIntOperation::Reduct].calls);
+}
+
+TEST(StatsTests, ToString) {
+    BigIntStats::reset();
+    BigInteger a = 1791791791;
+    a.toString();
+    auto stats = BigIntStats::snapshot()[BigIntOperation::ToString];
+    ASSERT_EQ(1, stats.calls);
+    ASSERT_LE(10, stats.allocated_bytes);
+}
+
+TEST(StatsTests, OtherThreads) {
+    BigIntStats::reset();
+    std::thread worker([]() {
+        BigInteger a = 179;
+        a *= BigInteger(57);
+    });
+    worker.join();
+    BigInteger b = 179;
+    b *= BigInteger(57);
+    auto stats = BigIntStats::snapshot();
+    ASSERT_EQ(2, stats[BigIntOperation::MultiplyFft].calls);
+}
+
+TEST(StatsTests, OperationName) {
+    ASSERT_EQ("multiply_fft", operation_name(BigIntOperation::MultiplyFft));
+    ASSERT_EQ("reduct", operation_name(BigIntOperation::Reduct));
+}
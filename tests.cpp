@@ -13,6 +13,13 @@
 #include "bigint_types_tests.h"
 #include "bigint_equalities_tests.h"
 #include "rational_tests.h"
+#include "modular_tests.h"
+#include "stats_tests.h"
+#include "algorithms_tests.h"
+#include "primes_tests.h"
+#include "bigint_bitwise_tests.h"
+#include "fixedint_tests.h"
+#include "sharedbiginteger_tests.h"
 
 
 int main(int argc, char** argv) {